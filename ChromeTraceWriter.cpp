@@ -0,0 +1,136 @@
+#include "ChromeTraceWriter.h"
+
+#include <charconv>
+#include <cstdio>
+#include <fstream>
+
+namespace {
+
+// Trace "processes" used to group the tracks
+const int kCpuGroup = 1;
+const int kIoGroup = 2;
+
+}  // namespace
+
+ChromeTraceWriter::ChromeTraceWriter(std::ostream& out, const std::vector<std::string>& rows, double us_per_tick)
+    : out(out), rows(rows), us_per_tick(us_per_tick) {
+    buffer.reserve(kChunkSize + 4096);
+    buffer += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    begin_event();
+    buffer += "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"CPUs\"}}";
+    begin_event();
+    buffer += "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":2,\"args\":{\"name\":\"I/O devices\"}}";
+}
+
+ChromeTraceWriter::~ChromeTraceWriter() {
+    finish();
+}
+
+void ChromeTraceWriter::begin_event() {
+    if (!first_event) buffer += ",\n";
+    first_event = false;
+}
+
+void ChromeTraceWriter::append_int(long long value) {
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    buffer.append(digits, result.ptr);
+}
+
+void ChromeTraceWriter::append_number(double value) {
+    if (value == (double)(long long)value) {
+        append_int((long long)value);
+        return;
+    }
+    char digits[32];
+    int len = std::snprintf(digits, sizeof(digits), "%.3f", value);
+    buffer.append(digits, len);
+}
+
+void ChromeTraceWriter::append_escaped(const std::string& text) {
+    for (char c : text) {
+        switch (c) {
+            case '"':  buffer += "\\\""; break;
+            case '\\': buffer += "\\\\"; break;
+            case '\n': buffer += "\\n"; break;
+            case '\t': buffer += "\\t"; break;
+            default:
+                if ((unsigned char)c < 0x20) {
+                    char esc[8];
+                    std::snprintf(esc, sizeof(esc), "\\u%04x", (unsigned char)c);
+                    buffer += esc;
+                } else {
+                    buffer += c;
+                }
+        }
+    }
+}
+
+void ChromeTraceWriter::name_track(SegmentKind kind, int resource) {
+    std::vector<bool>& named = kind == SegmentKind::Cpu ? cpu_track_named : io_track_named;
+    if (resource < (int)named.size() && named[resource]) return;
+    if (resource >= (int)named.size()) named.resize(resource + 1, false);
+    named[resource] = true;
+
+    begin_event();
+    buffer += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":";
+    append_int(kind == SegmentKind::Cpu ? kCpuGroup : kIoGroup);
+    buffer += ",\"tid\":";
+    append_int(resource);
+    buffer += kind == SegmentKind::Cpu ? ",\"args\":{\"name\":\"CPU " : ",\"args\":{\"name\":\"I/O ";
+    append_int(resource);
+    buffer += "\"}}";
+}
+
+void ChromeTraceWriter::flush_if_full() {
+    if (buffer.size() >= kChunkSize) {
+        out.write(buffer.data(), (std::streamsize)buffer.size());
+        buffer.clear();
+    }
+}
+
+void ChromeTraceWriter::add(const Segment& segment) {
+    name_track(segment.kind, segment.resource);
+
+    const std::string& pid = segment.row < (int)rows.size() ? rows[segment.row] : std::string();
+
+    begin_event();
+    buffer += "{\"name\":\"";
+    append_escaped(pid);
+    buffer += segment.kind == SegmentKind::Cpu ? "\",\"cat\":\"cpu\",\"ph\":\"X\",\"ts\":"
+                                               : "\",\"cat\":\"io\",\"ph\":\"X\",\"ts\":";
+    append_number(segment.start.ticks() * us_per_tick);
+    buffer += ",\"dur\":";
+    append_number((segment.end - segment.start).ticks() * us_per_tick);
+    buffer += ",\"pid\":";
+    append_int(segment.kind == SegmentKind::Cpu ? kCpuGroup : kIoGroup);
+    buffer += ",\"tid\":";
+    append_int(segment.resource);
+    buffer += "}";
+
+    flush_if_full();
+}
+
+void ChromeTraceWriter::add(const std::vector<Segment>& segments) {
+    for (const auto& s : segments) add(s);
+}
+
+void ChromeTraceWriter::finish() {
+    if (finished) return;
+    finished = true;
+    buffer += "\n]}\n";
+    out.write(buffer.data(), (std::streamsize)buffer.size());
+    buffer.clear();
+    out.flush();
+}
+
+bool export_chrome_trace(const SegmentTable& table, const std::string& filename, double us_per_tick) {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file) return false;
+
+    ChromeTraceWriter writer(file, table.rows, us_per_tick);
+    writer.add(table.segments);
+    writer.finish();
+    return (bool)file;
+}
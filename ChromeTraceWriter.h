@@ -0,0 +1,51 @@
+#ifndef CHROME_TRACE_WRITER_H
+#define CHROME_TRACE_WRITER_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Segment.h"
+
+// Streams segments as Chrome Trace Event JSON (loadable in Perfetto or
+// chrome://tracing). Every simulated CPU and every I/O device gets its own
+// track, and each segment becomes a slice named after the process.
+//
+// Events are formatted into a fixed-size buffer and handed to the stream
+// in large chunks, so memory stays flat however many segments are written.
+class ChromeTraceWriter {
+private:
+    std::ostream& out;
+    const std::vector<std::string>& rows;
+    std::string buffer;
+    std::vector<bool> cpu_track_named;
+    std::vector<bool> io_track_named;
+    double us_per_tick;
+    bool first_event = true;
+    bool finished = false;
+
+    void begin_event();
+    void append_int(long long value);
+    void append_number(double value);
+    void append_escaped(const std::string& text);
+    void name_track(SegmentKind kind, int resource);
+    void flush_if_full();
+
+public:
+    static const size_t kChunkSize = 1 << 20;
+
+    // rows: process IDs indexed by Segment::row. One tick is exported as
+    // us_per_tick microseconds.
+    ChromeTraceWriter(std::ostream& out, const std::vector<std::string>& rows, double us_per_tick = 1.0);
+    ~ChromeTraceWriter();
+
+    void add(const Segment& segment);
+    void add(const std::vector<Segment>& segments);
+
+    // Closes the JSON document and flushes the stream
+    void finish();
+};
+
+// Writes a whole schedule to a file; returns false if it cannot be opened
+bool export_chrome_trace(const SegmentTable& table, const std::string& filename, double us_per_tick = 1.0);
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef COW_ARRAY_H
+#define COW_ARRAY_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Array split into fixed-size chunks that copies share until one side
+// writes. Copying the array copies only the chunk pointers, so taking a
+// snapshot of a large simulation costs O(n / chunk size); afterwards each
+// copy clones just the chunks it modifies.
+//
+// Reads go through operator[], writes through mut() or push_back(). A copy
+// may be read from several threads while each thread writes its own copy.
+template <class T, size_t ChunkBits = 12>
+class CowArray {
+private:
+    using Chunk = std::vector<T>;
+
+    std::vector<std::shared_ptr<Chunk>> chunks;
+    size_t count = 0;
+
+    static constexpr size_t kMask = (size_t(1) << ChunkBits) - 1;
+
+    // Gives this array its own copy of a chunk before it is modified
+    Chunk& own(std::shared_ptr<Chunk>& chunk) {
+        if (chunk.use_count() > 1) {
+            auto copy = std::make_shared<Chunk>();
+            copy->reserve(kChunkSize);
+            copy->insert(copy->end(), chunk->begin(), chunk->end());
+            chunk = std::move(copy);
+        }
+        return *chunk;
+    }
+
+public:
+    static constexpr size_t kChunkSize = size_t(1) << ChunkBits;
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    const T& operator[](size_t i) const { return (*chunks[i >> ChunkBits])[i & kMask]; }
+    const T& back() const { return (*this)[count - 1]; }
+
+    T& mut(size_t i) { return own(chunks[i >> ChunkBits])[i & kMask]; }
+    T& back_mut() { return mut(count - 1); }
+
+    void push_back(const T& value) {
+        if ((count & kMask) == 0) {
+            chunks.push_back(std::make_shared<Chunk>());
+            chunks.back()->reserve(kChunkSize);
+            chunks.back()->push_back(value);
+        } else {
+            own(chunks.back()).push_back(value);
+        }
+        count++;
+    }
+
+    void clear() {
+        chunks.clear();
+        count = 0;
+    }
+
+    void reserve(size_t n) { chunks.reserve((n + kMask) >> ChunkBits); }
+
+    // Number of chunks this array shares with some other copy
+    size_t shared_chunks() const {
+        size_t shared = 0;
+        for (const auto& c : chunks) shared += c.use_count() > 1;
+        return shared;
+    }
+
+    std::vector<T> to_vector() const {
+        std::vector<T> out;
+        out.reserve(count);
+        for (const auto& c : chunks) out.insert(out.end(), c->begin(), c->end());
+        return out;
+    }
+};
+
+#endif
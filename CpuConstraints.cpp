@@ -0,0 +1,173 @@
+#include "CpuConstraints.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+namespace {
+
+// A non-negative decimal number filling all of `text`
+bool parse_count(const std::string& text, long long& value) {
+    if (text.empty() || text.size() > 18 || text.find_first_not_of("0123456789") != std::string::npos) return false;
+    value = std::atoll(text.c_str());
+    return true;
+}
+
+// "*", a process ID, or a range of numbered IDs such as "P10-P20"
+bool select_processes(const std::string& spec, const std::vector<Process>& processes,
+                      const std::map<std::string, int>& by_pid, std::vector<int>& selected) {
+    selected.clear();
+    if (spec == "*") {
+        for (size_t i = 0; i < processes.size(); i++) selected.push_back((int)i);
+        return true;
+    }
+    auto it = by_pid.find(spec);
+    if (it != by_pid.end()) {
+        selected.push_back(it->second);
+        return true;
+    }
+    size_t dash = spec.find('-');
+    long long first, last;
+    if (dash == std::string::npos || spec[0] != 'P' || dash + 1 >= spec.size() || spec[dash + 1] != 'P' ||
+        !parse_count(spec.substr(1, dash - 1), first) || !parse_count(spec.substr(dash + 2), last)) {
+        return false;
+    }
+    for (size_t i = 0; i < processes.size(); i++) {
+        const Process& p = processes[i];
+        if (p.process_id >= first && p.process_id <= last) selected.push_back((int)i);
+    }
+    return !selected.empty();
+}
+
+}  // namespace
+
+void CpuSet::add(int cpu) {
+    if (cpu < 0) return;
+    size_t w = (size_t)cpu / 64;
+    if (words.size() <= w) words.resize(w + 1, 0);
+    words[w] |= 1ull << (cpu % 64);
+}
+
+bool CpuSet::empty() const {
+    for (uint64_t w : words) {
+        if (w != 0) return false;
+    }
+    return true;
+}
+
+int CpuSet::count_below(int cpus) const {
+    int n = 0;
+    for (int c = 0; c < cpus && (size_t)c / 64 < words.size(); c++) n += contains(c);
+    return n;
+}
+
+bool CpuSet::parse(const std::string& text, CpuSet& set) {
+    set = CpuSet();
+    std::stringstream items(text);
+    std::string item;
+    while (std::getline(items, item, ',')) {
+        size_t dash = item.find('-');
+        long long first, last;
+        if (dash == std::string::npos) {
+            if (!parse_count(item, first)) return false;
+            last = first;
+        } else if (!parse_count(item.substr(0, dash), first) || !parse_count(item.substr(dash + 1), last)) {
+            return false;
+        }
+        // Far beyond any modelled machine (MultiCpu takes up to 4096 CPUs)
+        if (first > last || last >= 65536) return false;
+        for (long long c = first; c <= last; c++) set.add((int)c);
+    }
+    return !set.empty();
+}
+
+bool load_cpu_constraints(const std::string& filename, const std::vector<Process>& processes,
+                          CpuConstraints& constraints, std::string& error) {
+    std::ifstream file(filename);
+    if (!file) {
+        error = "cannot open " + filename;
+        return false;
+    }
+    constraints = CpuConstraints();
+    std::map<std::string, int> groups;
+    std::map<std::string, int> by_pid;
+    for (size_t i = 0; i < processes.size(); i++) by_pid.emplace(processes[i].pid, (int)i);
+
+    std::string line;
+    int number = 0;
+    std::vector<int> selected;
+    while (std::getline(file, line)) {
+        number++;
+        line = line.substr(0, line.find('#'));
+        std::istringstream words(line);
+        std::string directive;
+        if (!(words >> directive)) continue;
+        auto fail = [&](const std::string& message) {
+            error = filename + ":" + std::to_string(number) + ": " + message;
+            return false;
+        };
+
+        if (directive == "group") {
+            std::string name, quota, period, extra;
+            if (!(words >> name >> quota >> period) || (words >> extra)) {
+                return fail("expected \"group NAME QUOTA|max PERIOD\"");
+            }
+            if (groups.count(name) != 0) return fail("group " + name + " defined twice");
+            CpuGroup group;
+            group.name = name;
+            size_t slash = name.rfind('/');
+            if (slash != std::string::npos) {
+                auto parent = groups.find(name.substr(0, slash));
+                if (parent == groups.end()) return fail("parent of " + name + " is not defined");
+                group.parent = parent->second;
+            }
+            long long q = 0, p = 0;
+            if ((quota != "max" && (!parse_count(quota, q) || q == 0)) || !parse_count(period, p) || p == 0) {
+                return fail("quota and period must be positive (or quota \"max\")");
+            }
+            group.quota = SimTime(quota == "max" ? 0 : q);
+            group.period = SimTime(p);
+            groups.emplace(name, (int)constraints.groups.size());
+            constraints.groups.push_back(group);
+        } else if (directive == "process") {
+            std::string spec, key, value;
+            if (!(words >> spec)) return fail("expected \"process PIDS [cpus LIST] [group NAME]\"");
+            if (!select_processes(spec, processes, by_pid, selected)) return fail("no process matches " + spec);
+            if (constraints.affinity.empty()) {
+                constraints.affinity.resize(processes.size());
+                constraints.group.assign(processes.size(), -1);
+            }
+            while (words >> key) {
+                if (!(words >> value)) return fail("missing value for " + key);
+                if (key == "cpus") {
+                    CpuSet set;
+                    if (!CpuSet::parse(value, set)) return fail("bad CPU list " + value);
+                    for (int i : selected) constraints.affinity[i] = set;
+                } else if (key == "group") {
+                    auto group = groups.find(value);
+                    if (group == groups.end()) return fail("unknown group " + value);
+                    for (int i : selected) constraints.group[i] = group->second;
+                } else {
+                    return fail("unknown field " + key);
+                }
+            }
+        } else {
+            return fail("unknown directive " + directive);
+        }
+    }
+    return true;
+}
+
+bool check_affinity(const CpuConstraints& constraints, const std::vector<Process>& processes, int cpus,
+                    std::string& error) {
+    for (size_t i = 0; i < constraints.affinity.size() && i < processes.size(); i++) {
+        const CpuSet& mask = constraints.affinity[i];
+        if (!mask.empty() && mask.count_below(cpus) == 0) {
+            error = processes[i].pid + " may only run on CPUs the machine (" + std::to_string(cpus) +
+                    " CPUs) does not have";
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,69 @@
+#ifndef CPU_CONSTRAINTS_H
+#define CPU_CONSTRAINTS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Process.h"
+
+// Limits on where and how much processes may run in the multi-CPU model
+// (MultiCpu.h): CPU affinity masks, and cgroup-style bandwidth groups that
+// may use `quota` CPU-ticks per `period` ticks, summed over their threads
+// and all their subgroups.
+//
+// On disk, one directive per line ('#' starts a comment):
+//
+//   group batch 400 100              # up to 4 CPUs' worth per 100 ticks
+//   group batch/low 100 100          # a subgroup, also bounded by batch
+//   group web max 100                # no limit of its own
+//   process * cpus 0-7               # every process
+//   process P3 group batch/low
+//   process P10-P20 cpus 0-3,8 group web
+//
+// Group names are paths; a group's parent must be defined before it.
+// Later process lines override earlier ones for the fields they set.
+
+// CPUs by number, e.g. parsed from "0-3,8,10-11"
+class CpuSet {
+private:
+    std::vector<uint64_t> words;
+
+public:
+    void add(int cpu);
+    bool contains(int cpu) const {
+        size_t w = (size_t)cpu / 64;
+        return cpu >= 0 && w < words.size() && (words[w] >> (cpu % 64) & 1) != 0;
+    }
+    bool empty() const;
+    int count_below(int cpus) const;   // Of CPUs 0..cpus-1
+
+    // Returns false on malformed text
+    static bool parse(const std::string& text, CpuSet& set);
+};
+
+struct CpuGroup {
+    std::string name;     // Full path, e.g. "batch/low"
+    int parent = -1;
+    SimTime quota{};      // CPU-ticks per period; 0 for no limit
+    SimTime period{};
+};
+
+struct CpuConstraints {
+    std::vector<CpuGroup> groups;     // Parents before children
+    std::vector<CpuSet> affinity;     // Per process in input order; an empty set: any CPU
+    std::vector<int> group;           // Per process in input order; -1: none
+
+    bool empty() const { return groups.empty() && affinity.empty(); }
+};
+
+// Reads the directives above for `processes`. Returns false with a message
+// naming the line on malformed input, unknown groups or unknown processes.
+bool load_cpu_constraints(const std::string& filename, const std::vector<Process>& processes,
+                          CpuConstraints& constraints, std::string& error);
+
+// Every affinity mask must hold a CPU of a machine with `cpus` CPUs, or its
+// process could never run. Returns false naming the first that does not.
+bool check_affinity(const CpuConstraints& constraints, const std::vector<Process>& processes, int cpus,
+                    std::string& error);
+
+#endif
@@ -0,0 +1,42 @@
+#include "DecisionLatency.h"
+
+#include <algorithm>
+#include <chrono>
+
+double decision_ticks_per_ns() {
+#ifdef SCHED_DECISION_TSC
+    static const double ratio = [] {
+        auto start = std::chrono::steady_clock::now();
+        uint64_t ticks = decision_clock();
+        std::chrono::steady_clock::time_point now;
+        do {
+            now = std::chrono::steady_clock::now();
+        } while (now - start < std::chrono::milliseconds(10));
+        ticks = decision_clock() - ticks;
+        double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(now - start).count();
+        return ticks > 0 ? ticks / ns : 1.0;
+    }();
+    return ratio;
+#else
+    return 1.0;
+#endif
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    samples += other.samples;
+    total += other.total;
+    lowest = std::min(lowest, other.lowest);
+    highest = std::max(highest, other.highest);
+    for (size_t b = 0; b < kBuckets; b++) counts[b] += other.counts[b];
+}
+
+uint64_t LatencyHistogram::percentile(double q) const {
+    if (samples == 0) return 0;
+    uint64_t rank = (uint64_t)(std::clamp(q, 0.0, 1.0) * (samples - 1));
+    uint64_t seen = 0;
+    for (size_t b = 0; b < kBuckets; b++) {
+        seen += counts[b];
+        if (seen > rank) return std::clamp(bucket_floor(b), lowest, highest);
+    }
+    return highest;
+}
@@ -0,0 +1,139 @@
+#ifndef DECISION_LATENCY_H
+#define DECISION_LATENCY_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define SCHED_DECISION_TSC 1
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+// Wall-clock cost of the scheduling decisions themselves (ready-queue
+// inserts and picks), as opposed to the simulated outcome. Times come from
+// the time-stamp counter on x86 and from steady_clock elsewhere; either
+// way they are "ticks" that decision_ticks_per_ns() converts.
+//
+// Ops are sampled: with sample_every = N only every Nth op of each kind is
+// timed, so a run pays two counter reads per N ops.
+
+inline uint64_t decision_clock() {
+#ifdef SCHED_DECISION_TSC
+    return __rdtsc();
+#else
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+#endif
+}
+
+// Measured once per process against steady_clock (about 10 ms)
+double decision_ticks_per_ns();
+
+// Latencies in ticks, in buckets of a quarter octave: four linear
+// sub-buckets per power of two, so percentiles are within 25%
+class LatencyHistogram {
+public:
+    static constexpr size_t kSubBuckets = 4;
+    static constexpr size_t kBuckets = 64 * kSubBuckets;
+
+    uint64_t samples = 0;
+    uint64_t total = 0;
+    uint64_t lowest = UINT64_MAX;
+    uint64_t highest = 0;
+    std::array<uint64_t, kBuckets> counts{};
+
+    static size_t bucket_of(uint64_t ticks) {
+        if (ticks < kSubBuckets) return (size_t)ticks;
+        int octave = 63 - __builtin_clzll(ticks);   // >= 2
+        size_t sub = (size_t)(ticks >> (octave - 2)) & (kSubBuckets - 1);
+        return (size_t)(octave - 1) * kSubBuckets + sub;
+    }
+
+    // Smallest value that falls into `bucket`
+    static uint64_t bucket_floor(size_t bucket) {
+        if (bucket < kSubBuckets) return bucket;
+        int octave = (int)(bucket / kSubBuckets) + 1;
+        return ((uint64_t)(kSubBuckets + bucket % kSubBuckets)) << (octave - 2);
+    }
+
+    void add(uint64_t ticks) {
+        samples++;
+        total += ticks;
+        if (ticks < lowest) lowest = ticks;
+        if (ticks > highest) highest = ticks;
+        counts[bucket_of(ticks)]++;
+    }
+
+    void merge(const LatencyHistogram& other);
+    double mean() const { return samples > 0 ? (double)total / samples : 0; }
+
+    // Lower edge of the bucket holding quantile q (0..1), clamped to the
+    // observed range; 0 for no samples
+    uint64_t percentile(double q) const;
+};
+
+// Pick latency against the ready-queue length it chose from, per power of
+// two of the length, to show how a policy's decision scales
+struct LengthBin {
+    uint64_t samples = 0;
+    uint64_t total = 0;
+    double mean() const { return samples > 0 ? (double)total / samples : 0; }
+};
+
+struct DecisionLatency {
+    static constexpr size_t kLengthBins = 32;   // Bin b holds lengths in [2^b, 2^(b+1))
+
+    LatencyHistogram enqueue;
+    LatencyHistogram pick;
+    std::array<LengthBin, kLengthBins> pick_by_length{};
+    uint32_t sample_every = 0;   // 0: nothing was sampled
+
+    static size_t length_bin(size_t length) {
+        size_t b = length == 0 ? 0 : (size_t)(63 - __builtin_clzll((unsigned long long)length));
+        return b < kLengthBins ? b : kLengthBins - 1;
+    }
+
+    void add_pick(uint64_t ticks, size_t queue_length) {
+        pick.add(ticks);
+        LengthBin& bin = pick_by_length[length_bin(queue_length)];
+        bin.samples++;
+        bin.total += ticks;
+    }
+
+    bool empty() const { return enqueue.samples == 0 && pick.samples == 0; }
+};
+
+// Decides which ops to time: every Nth call of due(), none for N = 0
+class DecisionSampler {
+private:
+    uint32_t every = 0;
+    uint32_t countdown = 0;
+
+public:
+    DecisionSampler() = default;
+    explicit DecisionSampler(uint32_t sample_every) : every(sample_every), countdown(sample_every) {}
+
+    bool enabled() const { return every != 0; }
+    bool due() {
+        if (every == 0 || --countdown != 0) return false;
+        countdown = every;
+        return true;
+    }
+};
+
+// Runs pick() and, when the sampler says so, records its latency against
+// the queue length it chose from; for schedulers without a queue policy
+template <class Pick>
+auto timed_pick(DecisionSampler& sampler, DecisionLatency& latency, size_t queue_length, Pick pick) {
+    if (!sampler.due()) return pick();
+    uint64_t start = decision_clock();
+    auto picked = pick();
+    latency.add_pick(decision_clock() - start, queue_length);
+    return picked;
+}
+
+#endif
@@ -0,0 +1,52 @@
+#include "Energy.h"
+
+#include <algorithm>
+
+double EnergyModel::idle_energy(SimTime length, SimTime& wake) const {
+    wake = SimTime(0);
+    double energy = 0;
+    SimTime from{};     // Start of the current state's stretch
+    for (size_t k = 0; k < cstates.size() && length > SimTime(0); k++) {
+        const CState& state = cstates[k];
+        if (k > 0) {
+            if (length < state.promote_after) break;
+            // Still entering: the shallower state's power until the entry is done
+            SimTime entered = std::max(from, state.promote_after + state.entry_latency);
+            if (length < entered) {
+                energy += cstates[k - 1].power * (double)(length - from).ticks();
+                wake = state.exit_latency + entered - length;
+                return energy;
+            }
+            energy += cstates[k - 1].power * (double)(entered - from).ticks();
+            from = entered;
+        }
+        wake = state.exit_latency;
+        bool deepest = k + 1 == cstates.size() || length < cstates[k + 1].promote_after;
+        if (deepest) {
+            energy += state.power * (double)(length - from).ticks();
+            return energy;
+        }
+    }
+    return energy;
+}
+
+int EnergyModel::pick_pstate(FrequencyGovernor governor, long long demand, int cpus) const {
+    int fastest = (int)pstates.size() - 1;
+    if (governor == FrequencyGovernor::Powersave) return 0;
+    if (governor != FrequencyGovernor::OnDemand || cpus <= 0) return fastest;
+    long long load = demand * 100 / cpus;
+    for (int k = 0; k < fastest; k++) {
+        if (pstates[k].frequency >= load) return k;
+    }
+    return fastest;
+}
+
+EnergyModel EnergyModel::typical(SimTime deep_exit) {
+    EnergyModel model;
+    model.pstates = {{50, 0.49}, {70, 0.81}, {85, 1.22}, {100, 1.8}};
+    SimTime half = (deep_exit + SimTime(1)) / 2;
+    model.cstates = {{"C1", 0.3, SimTime(0), SimTime(0), SimTime(0)},
+                     {"C3", 0.15, deep_exit, half, half},
+                     {"C6", 0.02, 5 * deep_exit, deep_exit, deep_exit}};
+    return model;
+}
@@ -0,0 +1,58 @@
+#ifndef ENERGY_H
+#define ENERGY_H
+
+#include <vector>
+#include "SimTime.h"
+
+// Power states of one CPU for the multi-CPU model (MultiCpu.h).
+//
+// A running CPU is in one of its P-states: a clock frequency, in percent of
+// the nominal one that burst lengths are given at, and the power drawn at
+// it. A burst takes 100 / frequency times as long as at nominal speed.
+//
+// An idle CPU sinks through its C-states: once idle for `promote_after`
+// ticks it starts entering the next deeper state, which takes
+// `entry_latency` ticks at the shallower state's power. Work dispatched to
+// it waits for the exit first: `exit_latency` of the state it is in, plus
+// what is left of an entry under way. (Real idle governors predict the
+// idle time instead; the ladder needs no prediction.)
+struct PState {
+    int frequency = 100;     // Percent of nominal
+    double power = 0;        // Watts
+};
+
+struct CState {
+    const char* name = "";
+    double power = 0;        // Watts
+    SimTime promote_after{};
+    SimTime entry_latency{};
+    SimTime exit_latency{};
+};
+
+// How a CPU's P-state is chosen when work is dispatched to it
+enum class FrequencyGovernor {
+    None,          // No energy model: nominal speed, no idle-state latencies
+    Performance,   // Always the fastest
+    Powersave,     // Always the slowest
+    OnDemand       // The slowest that covers the machine's load (running + ready threads)
+};
+
+struct EnergyModel {
+    std::vector<PState> pstates;   // Slowest first; the last is nominal
+    std::vector<CState> cstates;   // Shallowest first; the first is entered at once
+
+    // Energy in watt-ticks of a CPU idle for `length` ticks; `wake` is set
+    // to how long work dispatched at its end waits for the CPU
+    double idle_energy(SimTime length, SimTime& wake) const;
+
+    // Index of the P-state `governor` picks with `demand` threads wanting
+    // one of `cpus` CPUs
+    int pick_pstate(FrequencyGovernor governor, long long demand, int cpus) const;
+
+    // A laptop-class core: power roughly 0.3 W static plus a dynamic part
+    // growing with the cube of the frequency, and halt, C3 and C6 idle
+    // states; C6 takes `deep_exit` ticks to leave
+    static EnergyModel typical(SimTime deep_exit);
+};
+
+#endif
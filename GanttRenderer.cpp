@@ -0,0 +1,126 @@
+#include "GanttRenderer.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+const int kDefaultColumns = 80;
+const int kMinCells = 10;
+
+int terminal_columns() {
+    const char* env = std::getenv("COLUMNS");
+    if (env != nullptr) {
+        int cols = std::atoi(env);
+        if (cols > 0) return cols;
+    }
+    return kDefaultColumns;
+}
+
+}  // namespace
+
+GanttRenderer::GanttRenderer(int width) : width(width) {}
+
+std::string GanttRenderer::render(const SegmentTable& table) const {
+    std::string out;
+    if (table.rows.empty()) return out;
+
+    size_t label_width = 0;
+    for (const auto& pid : table.rows) label_width = std::max(label_width, pid.size());
+    const int prefix = (int)label_width + 3;   // "P1 : "
+
+    int cells = width > 0 ? width : terminal_columns() - prefix - 1;
+    cells = std::max(cells, kMinCells);
+
+    const int64_t span = std::max<int64_t>(table.end_time.ticks(), 1);
+    const int64_t ticks_per_cell = (span + cells - 1) / cells;
+    cells = (int)((span + ticks_per_cell - 1) / ticks_per_cell);
+
+    out.reserve((table.rows.size() + 3) * (prefix + cells + 2));
+
+    // Axis: labels every 5 cells at full resolution, every 10 once scaled
+    const int label_step = ticks_per_cell == 1 ? 5 : 10;
+    std::string labels(prefix + cells + 1, ' ');
+    std::string ticks(prefix + cells + 1, ' ');
+    int next_free = prefix;
+    for (int c = 0; c <= cells; c += label_step) {
+        int col = prefix + c;
+        ticks[col] = '|';
+        std::string text = std::to_string(c * ticks_per_cell);
+        if (col >= next_free) {
+            if (labels.size() < col + text.size()) labels.resize(col + text.size(), ' ');
+            labels.replace(col, text.size(), text);
+            next_free = col + (int)text.size() + 1;
+        }
+    }
+    if (ticks_per_cell > 1) {
+        out += "Scale: 1 cell = " + std::to_string(ticks_per_cell) + " ticks\n";
+    }
+    out += labels;
+    out += '\n';
+    out += ticks;
+    out += '\n';
+
+    // Bucket segments by row (counting sort) so each row is one pass
+    const size_t rows = table.rows.size();
+    std::vector<size_t> offsets(rows + 1, 0);
+    for (const auto& s : table.segments) offsets[s.row + 1]++;
+    for (size_t r = 0; r < rows; r++) offsets[r + 1] += offsets[r];
+    std::vector<size_t> by_row(table.segments.size());
+    {
+        std::vector<size_t> fill(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < table.segments.size(); i++) {
+            by_row[fill[table.segments[i].row]++] = i;
+        }
+    }
+
+    std::vector<int64_t> cpu(cells), io(cells);
+
+    for (size_t r = 0; r < rows; r++) {
+        std::fill(cpu.begin(), cpu.end(), 0);
+        std::fill(io.begin(), io.end(), 0);
+
+        for (size_t k = offsets[r]; k < offsets[r + 1]; k++) {
+            const Segment& s = table.segments[by_row[k]];
+            std::vector<int64_t>& acc = s.kind == SegmentKind::Cpu ? cpu : io;
+
+            const int64_t start = s.start.ticks(), end = s.end.ticks();
+            int64_t first = start / ticks_per_cell;
+            int64_t last = (end - 1) / ticks_per_cell;
+            if (first == last) {
+                acc[first] += end - start;
+                continue;
+            }
+            acc[first] += (first + 1) * ticks_per_cell - start;
+            for (int64_t c = first + 1; c < last; c++) acc[c] += ticks_per_cell;
+            acc[last] += end - last * ticks_per_cell;
+        }
+
+        const std::string& pid = table.rows[r];
+        out += pid;
+        out.append(label_width - pid.size(), ' ');
+        out += " : ";
+        for (int c = 0; c < cells; c++) {
+            int64_t len = std::min<int64_t>(ticks_per_cell, span - c * ticks_per_cell);
+            int64_t idle = len - cpu[c] - io[c];
+            if (cpu[c] > 0 && cpu[c] >= io[c] && cpu[c] >= idle) {
+                out += 'C';
+            } else if (io[c] > 0 && io[c] >= idle) {
+                out += 'I';
+            } else {
+                out += ' ';
+            }
+        }
+        out += '\n';
+    }
+
+    return out;
+}
+
+void GanttRenderer::print(const SegmentTable& table, std::ostream& out) const {
+    std::string text = render(table);
+    out.write(text.data(), (std::streamsize)text.size());
+    out.flush();
+}
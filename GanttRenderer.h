@@ -0,0 +1,24 @@
+#ifndef GANTT_RENDERER_H
+#define GANTT_RENDERER_H
+
+#include <iostream>
+#include <string>
+#include "Segment.h"
+
+// ASCII Gantt chart built from run-length segments. When the schedule is
+// longer than the terminal is wide, each cell covers several ticks and shows
+// whichever state (CPU, I/O or idle) dominates it.
+class GanttRenderer {
+private:
+    int width;   // Timeline cells; 0 = fit the terminal ($COLUMNS)
+
+public:
+    explicit GanttRenderer(int width = 0);
+
+    std::string render(const SegmentTable& table) const;
+
+    // Renders into one buffer and hands it to the stream in a single write
+    void print(const SegmentTable& table, std::ostream& out = std::cout) const;
+};
+
+#endif
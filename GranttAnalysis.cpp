@@ -1,73 +1,275 @@
 #include "GranttAnalysis.h"
 
-GranttAnalysis::GranttAnalysis(std::vector<ProcessGrantInfo> chart, std::vector<Process> processes) {
-    grantt_chart = chart;
-
-    // Map process info back to original processes
-    for (auto &info : grantt_chart) {
-        for (auto &p : processes) {
-            if (info.process.pid == p.pid) {
-                info.process = p;
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include "Instrumentation.h"
+
+namespace {
+
+// Time covered by the records of one process so far
+struct Span {
+    SimTime start{};
+    SimTime end{};
+    size_t records = 0;
+};
+
+// Widens a span to cover one chart record. Legacy schedulers leave the
+// bursts a record does not cover at 0, so only non-empty intervals count;
+// a record without any (zero-length bursts) falls back to its own start
+// and end.
+void fold_record(Span& span, const ProcessGrantInfo& info) {
+    SimTime first = kSimTimeMax;
+    SimTime last = kSimTimeMin;
+    if (info.cpu_start_time1 >= SimTime(0) && info.cpu_end_time1 > info.cpu_start_time1) {
+        first = std::min(first, info.cpu_start_time1);
+        last = std::max(last, info.cpu_end_time1);
+    }
+    if (info.cpu_start_time2 >= SimTime(0) && info.cpu_end_time2 > info.cpu_start_time2) {
+        first = std::min(first, info.cpu_start_time2);
+        last = std::max(last, info.cpu_end_time2);
+    }
+    if (info.io_start_time >= SimTime(0) && info.io_end_time > info.io_start_time) {
+        last = std::max(last, info.io_end_time);
+    }
+    if (first == kSimTimeMax) first = info.get_start_time();
+    if (last == kSimTimeMin) last = info.get_end_time();
+
+    if (span.records == 0) {
+        span.start = first;
+        span.end = last;
+    } else {
+        span.start = std::min(span.start, first);
+        span.end = std::max(span.end, last);
+    }
+    span.records++;
+}
+
+// Open-addressing map from process ID to slot. Entries hold the upper
+// hash bits next to the slot, so a probe compares IDs only on a likely
+// match; the IDs themselves stay in the caller's vectors.
+class SlotIndex {
+private:
+    std::vector<uint64_t> entries;   // (hash tag << 32) | (slot + 1); 0 is empty
+    std::vector<std::string_view> ids;   // By slot
+    size_t used = 0;
+    size_t mask = 0;
+
+    static uint64_t hash_of(std::string_view id) { return std::hash<std::string_view>()(id) * 0x9E3779B97F4A7C15ull; }
+
+    void grow() {
+        std::vector<uint64_t> old;
+        old.swap(entries);
+        entries.assign(std::max<size_t>(16, old.size() * 2), 0);
+        mask = entries.size() - 1;
+        for (uint64_t e : old) {
+            if (e == 0) continue;
+            size_t pos = (size_t)hash_of(ids[(e & 0xFFFFFFFFu) - 1]) & mask;
+            while (entries[pos] != 0) pos = (pos + 1) & mask;
+            entries[pos] = e;
+        }
+    }
+
+public:
+    explicit SlotIndex(size_t expected) {
+        size_t capacity = 16;
+        while (capacity < expected * 2) capacity *= 2;
+        entries.assign(capacity, 0);
+        mask = capacity - 1;
+        ids.reserve(expected);
+    }
+
+    // Slot of `id`, or `fresh` (which must be the next slot) if it is new.
+    // A repeated ID keeps its first slot.
+    size_t find_or_add(std::string_view id, size_t fresh) {
+        uint64_t hash = hash_of(id);
+        uint64_t tag = hash >> 32;
+        size_t pos = (size_t)hash & mask;
+        while (entries[pos] != 0) {
+            uint64_t e = entries[pos];
+            size_t slot = (size_t)(e & 0xFFFFFFFFu) - 1;
+            if ((e >> 32) == tag && ids[slot] == id) return slot;
+            pos = (pos + 1) & mask;
+        }
+        entries[pos] = (tag << 32) | (uint64_t)(fresh + 1);
+        if (ids.size() <= fresh) ids.resize(fresh + 1);
+        ids[fresh] = id;
+        if (++used * 2 > entries.size()) grow();
+        return fresh;
+    }
+};
+
+}  // namespace
+
+std::vector<ProcessCompletion> aggregate_chart(const std::vector<ProcessGrantInfo>& chart,
+                                               const std::vector<Process>& processes) {
+    // Slot i < processes.size() is processes[i]; unknown IDs get slots after
+    std::vector<Span> spans(processes.size());
+    std::vector<const Process*> slot_process;
+    slot_process.reserve(processes.size());
+    for (const auto& p : processes) slot_process.push_back(&p);
+
+    // Built on the first record that is not at its process's position
+    std::optional<SlotIndex> slot_of;
+    std::string_view last_pid;
+    size_t last_slot = 0;
+
+    for (size_t r = 0; r < chart.size(); r++) {
+        const ProcessGrantInfo& info = chart[r];
+        const std::string& pid = info.process.pid;
+        size_t slot = r;
+        if (r >= processes.size() || processes[r].pid != pid) {
+            if (!slot_of) {
+                slot_of.emplace(processes.size());
+                for (size_t i = 0; i < processes.size(); i++) slot_of->find_or_add(processes[i].pid, i);
+            }
+            if (!last_pid.empty() && last_pid == pid) {
+                slot = last_slot;   // Consecutive slices of one process
+            } else {
+                slot = slot_of->find_or_add(pid, spans.size());
+                if (slot == spans.size()) {
+                    spans.emplace_back();
+                    slot_process.push_back(&info.process);
+                }
+                last_pid = pid;
+                last_slot = slot;
             }
         }
+        fold_record(spans[slot], info);
     }
+
+    // Processes that never appear in the chart have no outcome
+    std::vector<ProcessCompletion> completions;
+    for (size_t i = 0; i < spans.size(); i++) {
+        if (spans[i].records == 0) continue;
+        completions.emplace_back();
+        ProcessCompletion& c = completions.back();
+        c.process = *slot_process[i];
+        c.start = spans[i].start;
+        c.end = spans[i].end;
+        c.records = spans[i].records;
+    }
+    return completions;
+}
+
+GranttAnalysis::GranttAnalysis(const std::vector<ProcessGrantInfo>& chart, const std::vector<Process>& processes,
+                               TimeUnit time_unit)
+    : record_count(chart.size()), unit(time_unit) {
+    SCHED_TIME_SCOPE(Stage::Analysis);
+    completions = aggregate_chart(chart, processes);
+    columns.reserve(completions.size());
+    for (const auto& c : completions) {
+        columns.push_back(c.process.arrival_time, c.process.cpu_burst_time1 + c.process.cpu_burst_time2, c.start, c.end);
+    }
+}
+
+void GranttAnalysis::derive() {
+    if (response.size() == columns.size()) return;
+    SCHED_TIME_SCOPE(Stage::Analysis);
+    response.resize(columns.size());
+    turnaround.resize(columns.size());
+    waiting.resize(columns.size());
+    derive_metrics(columns, response.data(), turnaround.data(), waiting.data());
 }
 
 void GranttAnalysis::calculate_turn_around_time() {
-    for (auto &info : grantt_chart) {
-        turn_around_time.push_back({info.process, info.get_end_time() - info.process.arrival_time});
+    derive();
+    for (size_t i = 0; i < completions.size(); i++) {
+        turn_around_time.push_back({completions[i].process, SimTime(turnaround[i])});
     }
 }
 
 void GranttAnalysis::calculate_waiting_time() {
-    for (auto &info : grantt_chart) {
-        int wt = (info.get_end_time() - info.process.arrival_time) -
-                 (info.process.cpu_burst_time1 + info.process.cpu_burst_time2);
-        waiting_time.push_back({info.process, wt});
-    }
+    derive();
+    for (size_t i = 0; i < completions.size(); i++) waiting_time.push_back({completions[i].process, SimTime(waiting[i])});
 }
 
 void GranttAnalysis::calculate_response_time() {
-    for (auto &info : grantt_chart) {
-        int rt = info.get_start_time() - info.process.arrival_time;
-        response_time.push_back({info.process, rt});
-    }
+    derive();
+    for (size_t i = 0; i < completions.size(); i++) response_time.push_back({completions[i].process, SimTime(response[i])});
 }
 
-int GranttAnalysis::get_total_time() const {
-    int max_end_time = 0;
-    for (auto &info : grantt_chart) {
-        max_end_time = std::max(max_end_time, info.get_end_time());
-    }
-    return max_end_time;
+SimTime GranttAnalysis::get_total_time() const {
+    int64_t lowest = 0, highest = 0;
+    metric_min_max(columns.end.data(), columns.size(), lowest, highest);
+    return SimTime(std::max<int64_t>(highest, 0));
 }
 
-int GranttAnalysis::get_idle_time() const {
+SimTime GranttAnalysis::get_idle_time() const {
     return get_total_time() - get_burst_time();
 }
 
-int GranttAnalysis::get_burst_time() const {
-    int sum = 0;
-    for (auto &info : grantt_chart) {
-        sum += info.process.cpu_burst_time1 + info.process.cpu_burst_time2;
-    }
-    return sum;
+SimTime GranttAnalysis::get_burst_time() const {
+    SimTime burst{};
+    metric_sum(columns.burst.data(), columns.size()).value(burst);
+    return burst;
 }
 
 double GranttAnalysis::get_cpu_efficiency() const {
-    return static_cast<double>(get_burst_time()) / get_total_time();
+    return static_cast<double>(get_burst_time().ticks()) / get_total_time().ticks();
 }
 
 double GranttAnalysis::get_throughput() const {
-    return (static_cast<double>(grantt_chart.size()) * 1000) / get_total_time();
+    return static_cast<double>(completions.size()) * ticks_per_second(unit) / get_total_time().ticks();
+}
+
+AnalysisSummary GranttAnalysis::summary() const {
+    SCHED_TIME_SCOPE(Stage::Analysis);
+    AnalysisSummary result;
+    result.records = record_count;
+    result.processes = completions.size();
+
+    // One pass over the columns gives every sum
+    MetricTotals totals = metric_totals(columns);
+    if (result.processes > 0) {
+        result.avg_response_time = totals.response.as_double() / result.processes;
+        result.avg_turnaround_time = totals.turnaround.as_double() / result.processes;
+        result.avg_waiting_time = totals.waiting.as_double() / result.processes;
+    }
+
+    result.total_time = std::max<SimTime>(totals.last_end, SimTime(0));
+    result.overflow = !totals.burst.value(result.burst_time);
+    TimeSum idle = TimeSum(0, (uint64_t)result.total_time.ticks()) - totals.burst;
+    result.overflow = !idle.value(result.idle_time) || result.overflow;
+    if (result.total_time > SimTime(0)) {
+        result.cpu_efficiency = totals.burst.as_double() / result.total_time.ticks();
+        result.throughput = static_cast<double>(result.processes) * ticks_per_second(unit) / result.total_time.ticks();
+    }
+    return result;
+}
+
+void apply_machine_totals(AnalysisSummary& summary, const MultiCpuStats& stats) {
+    summary.idle_time = stats.idle_time;
+    summary.cpu_efficiency = stats.capacity() > 0 ? (double)stats.busy_time.ticks() / stats.capacity() : 0;
+}
+
+TurnaroundHistogram GranttAnalysis::turnaround_histogram(size_t buckets) {
+    TurnaroundHistogram histogram;
+    if (buckets == 0 || completions.empty()) return histogram;
+    derive();
+    SCHED_TIME_SCOPE(Stage::Analysis);
+    int64_t lowest = turnaround[0], highest = turnaround[0];
+    metric_min_max(turnaround.data(), turnaround.size(), lowest, highest);
+
+    // The span can exceed int64_t; buckets past a saturated width are never needed
+    uint64_t span = (uint64_t)highest - (uint64_t)lowest;
+    uint64_t width = std::min<uint64_t>(span / buckets + 1, std::numeric_limits<int64_t>::max());
+    histogram.lowest = SimTime(lowest);
+    histogram.width = SimTime((int64_t)width);
+    histogram.counts.assign(std::min<uint64_t>(buckets, span / width + 1), 0);
+    metric_histogram(turnaround.data(), turnaround.size(), lowest, (int64_t)width, histogram.counts);
+    return histogram;
 }
 
 void GranttAnalysis::pretty_print(const std::string& status) {
     calculate_response_time();
     calculate_turn_around_time();
     calculate_waiting_time();
-
-    double resp_avg = 0, tat_avg = 0, wt_avg = 0;
+    AnalysisSummary totals = summary();
 
     std::cout << "=======================================================================================================\n";
     std::cout << "                                               " << status << "\n";
@@ -75,29 +277,22 @@ void GranttAnalysis::pretty_print(const std::string& status) {
 
     std::cout << "\tPID\tResponse\tTurnaround\tWaiting\tStart\tEnd\n";
 
-    for (size_t i = 0; i < grantt_chart.size(); i++) {
-        std::cout << "\t" << grantt_chart[i].process.pid
+    for (size_t i = 0; i < completions.size(); i++) {
+        std::cout << "\t" << completions[i].process.pid
                   << "\t" << response_time[i].second
                   << "\t\t" << turn_around_time[i].second
                   << "\t\t" << waiting_time[i].second
-                  << "\t\t" << grantt_chart[i].get_start_time()
-                  << "\t" << grantt_chart[i].get_end_time() << "\n";
-
-        resp_avg += response_time[i].second;
-        tat_avg += turn_around_time[i].second;
-        wt_avg += waiting_time[i].second;
+                  << "\t\t" << completions[i].start
+                  << "\t" << completions[i].end << "\n";
     }
 
-    resp_avg /= response_time.size();
-    tat_avg /= turn_around_time.size();
-    wt_avg /= waiting_time.size();
-
     std::cout << "-------------------------------------------------------------------------------------------------------\n";
-    std::cout << "Avg\t\t" << resp_avg << "\t\t" << tat_avg << "\t\t" << wt_avg << "\n";
+    std::cout << "Avg\t\t" << totals.avg_response_time << "\t\t" << totals.avg_turnaround_time << "\t\t"
+              << totals.avg_waiting_time << "\n";
 
-    std::cout << "Total Time: " << get_total_time() << "\n";
-    std::cout << "Idle Time: " << get_idle_time() << "\n";
-    std::cout << "Burst Time: " << get_burst_time() << "\n";
+    std::cout << "Total Time: " << totals.total_time << "\n";
+    std::cout << "Idle Time: " << totals.idle_time << "\n";
+    std::cout << "Burst Time: " << totals.burst_time << "\n";
     std::cout << "Efficiency: " << get_cpu_efficiency() << "\n";
     std::cout << "Throughput: " << get_throughput() << " per second\n";
 
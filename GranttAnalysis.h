@@ -4,28 +4,90 @@
 #include <vector>
 #include <iostream>
 #include <iomanip>
+#include "MetricKernels.h"
+#include "MultiCpuStats.h"
+#include "Process.h"
 #include "ProcessGrantInfo.h"
 
+// One process's outcome, however many chart records the scheduler split it
+// into (RR and MLFQ emit one per slice)
+struct ProcessCompletion {
+    Process process;     // As given to the scheduler, not a record's copy
+    SimTime start{};     // First time it held the CPU
+    SimTime end{};       // When its last burst finished
+    size_t records = 0;  // Chart records it was grouped from
+};
+
+// Groups chart records by process in one pass, giving one completion per
+// process that appears in the chart: processes in input order first, then
+// records with unknown IDs in order of appearance. Charts that list the
+// processes in input order (the policy engines) skip the ID lookup.
+std::vector<ProcessCompletion> aggregate_chart(const std::vector<ProcessGrantInfo>& chart,
+                                               const std::vector<Process>& processes);
+
+// Averages and totals shown by pretty_print(), for machine-readable output
+struct AnalysisSummary {
+    size_t records = 0;     // Chart records, possibly several per process
+    size_t processes = 0;   // Processes they add up to; averages are over these
+    double avg_response_time = 0;
+    double avg_turnaround_time = 0;
+    double avg_waiting_time = 0;
+    SimTime total_time{};
+    SimTime idle_time{};     // CPU-ticks over the whole machine after apply_machine_totals()
+    SimTime burst_time{};
+    double cpu_efficiency = 0;   // Busy share of one CPU, or of the machine (see above)
+    double throughput = 0;   // Processes per second of the analysis's time unit
+    bool overflow = false;   // A total did not fit in a SimTime and was saturated
+};
+
+// For a multi-CPU run, replaces the one-CPU idle time and efficiency (the
+// chart's bursts against its length, which overlap on several CPUs) with
+// the machine's: idle CPU-ticks, and busy CPU-ticks over cpus * makespan
+void apply_machine_totals(AnalysisSummary& summary, const MultiCpuStats& stats);
+
+// Completions by turnaround: counts[k] covers turnarounds from
+// lowest + k * width up to, not including, lowest + (k + 1) * width
+struct TurnaroundHistogram {
+    SimTime lowest{};
+    SimTime width{};
+    std::vector<uint64_t> counts;
+};
+
 class GranttAnalysis {
 private:
-    std::vector<ProcessGrantInfo> grantt_chart;
-    std::vector<std::pair<Process, int>> turn_around_time;
-    std::vector<std::pair<Process, int>> response_time;
-    std::vector<std::pair<Process, int>> waiting_time;
+    std::vector<ProcessCompletion> completions;
+    MetricColumns columns;   // The completions' times, for the metric kernels
+    size_t record_count = 0;
+    TimeUnit unit;
+    std::vector<int64_t> response, turnaround, waiting;   // Ticks per completion, filled by derive()
+    std::vector<std::pair<Process, SimTime>> turn_around_time;
+    std::vector<std::pair<Process, SimTime>> response_time;
+    std::vector<std::pair<Process, SimTime>> waiting_time;
+
+    void derive();
 
 public:
-    GranttAnalysis(std::vector<ProcessGrantInfo> chart, std::vector<Process> processes);
+    // `time_unit` is what one tick of the chart stands for; it only scales
+    // the throughput
+    GranttAnalysis(const std::vector<ProcessGrantInfo>& chart, const std::vector<Process>& processes,
+                   TimeUnit time_unit = TimeUnit::Milliseconds);
 
     void calculate_turn_around_time();
     void calculate_waiting_time();
     void calculate_response_time();
 
-    int get_total_time() const;
-    int get_idle_time() const;
-    int get_burst_time() const;
+    SimTime get_total_time() const;
+    SimTime get_idle_time() const;
+    SimTime get_burst_time() const;
     double get_cpu_efficiency() const;
     double get_throughput() const;
 
+    AnalysisSummary summary() const;
+
+    // At most `buckets` equal-width buckets from the shortest turnaround to
+    // the longest; none when there are no completions
+    TurnaroundHistogram turnaround_histogram(size_t buckets);
+
     void pretty_print(const std::string& status);
 };
 
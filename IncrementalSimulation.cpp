@@ -0,0 +1,169 @@
+#include "IncrementalSimulation.h"
+
+#include <algorithm>
+
+namespace {
+
+// Arrival-order comparison of workload indices, ties in input order
+struct ByArrival {
+    const std::vector<Process>& workload;
+    bool operator()(int a, int b) const {
+        SimTime ta = workload[a].arrival_time, tb = workload[b].arrival_time;
+        return ta != tb ? ta < tb : a < b;
+    }
+};
+
+bool same_process(const Process& a, const Process& b) {
+    return a.pid == b.pid && a.arrival_time == b.arrival_time && a.cpu_burst_time1 == b.cpu_burst_time1 &&
+           a.io_time == b.io_time && a.cpu_burst_time2 == b.cpu_burst_time2 && a.priority == b.priority;
+}
+
+}  // namespace
+
+IncrementalSimulation::IncrementalSimulation(int checkpoint_count) : checkpoint_limit(std::max(checkpoint_count, 1)) {}
+
+bool IncrementalSimulation::start(const std::string& algorithm_name, const SchedulerParams& algorithm_params,
+                                  std::vector<Process> workload, std::string& error) {
+    const SchedulerInfo* info = SchedulerRegistry::instance().find(algorithm_name);
+    if (info == nullptr) {
+        error = "unknown algorithm " + algorithm_name;
+        return false;
+    }
+    algorithm = algorithm_name;
+    params = algorithm_params;
+    resumable = info->resumable();
+
+    SimulationSnapshot first = initial_snapshot(std::make_shared<const std::vector<Process>>(std::move(workload)));
+    processes = first.workload;
+    order = first.arrival_order;
+
+    // Edits are placed by arrival time, so checkpoints past the last
+    // arrival would never be resumed from
+    SimTime last_arrival = order->empty() ? SimTime(0) : (*processes)[order->back()].arrival_time;
+    interval = std::max(SimTime(1), last_arrival / checkpoint_limit + SimTime(1));
+
+    checkpoints.clear();
+    if (resumable) checkpoints.push_back(std::move(first));
+    return run_from(0, error);
+}
+
+bool IncrementalSimulation::run_from(size_t checkpoint, std::string& error) {
+    const SchedulerRegistry& registry = SchedulerRegistry::instance();
+    output = ScheduleCollector();
+    if (!resumable) {
+        resumed_at = SimTime(0);
+        return registry.run(algorithm, *processes, params, output, error);
+    }
+
+    checkpoints.resize(checkpoint + 1);
+    resumed_at = checkpoints.back().time;
+    for (int k = (int)checkpoint + 1; k < checkpoint_limit && !checkpoints.back().finished(); k++) {
+        SimulationSnapshot paused;
+        if (!registry.resume_until(algorithm, checkpoints.back(), params, k * interval, paused, error)) return false;
+        checkpoints.push_back(std::move(paused));
+    }
+    return registry.resume(algorithm, checkpoints.back(), params, output, error);
+}
+
+bool IncrementalSimulation::apply(std::vector<Process> edited, std::vector<int> edited_order, SimTime change_time,
+                                  std::string& error) {
+    processes = std::make_shared<const std::vector<Process>>(std::move(edited));
+    order = std::make_shared<const std::vector<int>>(std::move(edited_order));
+
+    // Checkpoints up to the change hold only processes that arrived before
+    // it, and those kept their relative order, so the new arrival order
+    // describes them as well
+    size_t keep = 0;
+    while (keep + 1 < checkpoints.size() && checkpoints[keep + 1].time <= change_time) keep++;
+    checkpoints.resize(std::min(checkpoints.size(), keep + 1));
+    for (auto& c : checkpoints) {
+        c.workload = processes;
+        c.arrival_order = order;
+    }
+    return run_from(keep, error);
+}
+
+bool IncrementalSimulation::replace(size_t index, const Process& process, std::string& error) {
+    if (!started() || index >= processes->size()) {
+        error = "no process " + std::to_string(index + 1);
+        return false;
+    }
+    const std::vector<Process>& old = *processes;
+    std::vector<int> edited_order = *order;
+    edited_order.erase(std::lower_bound(edited_order.begin(), edited_order.end(), (int)index, ByArrival{old}));
+
+    std::vector<Process> edited = old;
+    edited[index] = process;
+    edited_order.insert(std::lower_bound(edited_order.begin(), edited_order.end(), (int)index, ByArrival{edited}),
+                        (int)index);
+
+    SimTime change_time = std::min(old[index].arrival_time, process.arrival_time);
+    return apply(std::move(edited), std::move(edited_order), change_time, error);
+}
+
+bool IncrementalSimulation::add(const Process& process, std::string& error) {
+    if (!started()) {
+        error = "no simulation to add to";
+        return false;
+    }
+    std::vector<Process> edited = *processes;
+    edited.push_back(process);
+    int index = (int)edited.size() - 1;
+    std::vector<int> edited_order = *order;
+    edited_order.insert(std::lower_bound(edited_order.begin(), edited_order.end(), index, ByArrival{edited}), index);
+    return apply(std::move(edited), std::move(edited_order), process.arrival_time, error);
+}
+
+bool IncrementalSimulation::remove(size_t index, std::string& error) {
+    if (!started() || index >= processes->size()) {
+        error = "no process " + std::to_string(index + 1);
+        return false;
+    }
+    const std::vector<Process>& old = *processes;
+    std::vector<int> edited_order = *order;
+    edited_order.erase(std::lower_bound(edited_order.begin(), edited_order.end(), (int)index, ByArrival{old}));
+    // Later processes move up one place; their relative order is unchanged
+    for (int& i : edited_order) i -= i > (int)index;
+
+    std::vector<Process> edited = old;
+    edited.erase(edited.begin() + index);
+    SimTime change_time = old[index].arrival_time;
+    return apply(std::move(edited), std::move(edited_order), change_time, error);
+}
+
+bool IncrementalSimulation::update(std::vector<Process> workload, std::string& error) {
+    if (!started()) {
+        error = "no simulation to update";
+        return false;
+    }
+    const std::vector<Process>& old = *processes;
+    const size_t n = std::max(old.size(), workload.size());
+
+    std::vector<char> changed(n, 0);
+    std::vector<int> moved;   // Changed or new indices still in the workload
+    bool any = false;
+    SimTime change_time{};
+    for (size_t i = 0; i < n; i++) {
+        bool in_old = i < old.size(), in_new = i < workload.size();
+        if (in_old && in_new && same_process(old[i], workload[i])) continue;
+        SimTime at = in_old && in_new ? std::min(old[i].arrival_time, workload[i].arrival_time)
+                                  : (in_old ? old[i] : workload[i]).arrival_time;
+        change_time = any ? std::min(change_time, at) : at;
+        any = true;
+        changed[i] = 1;
+        if (in_new) moved.push_back((int)i);
+    }
+    if (!any) return true;
+
+    // Unchanged processes keep their order; the changed ones merge back in
+    std::vector<int> kept;
+    kept.reserve(workload.size());
+    for (int i : *order) {
+        if (!changed[i]) kept.push_back(i);
+    }
+    ByArrival by_arrival{workload};
+    std::sort(moved.begin(), moved.end(), by_arrival);
+    std::vector<int> edited_order(kept.size() + moved.size());
+    std::merge(kept.begin(), kept.end(), moved.begin(), moved.end(), edited_order.begin(), by_arrival);
+    return apply(std::move(workload), std::move(edited_order), change_time, error);
+}
@@ -0,0 +1,72 @@
+#ifndef INCREMENTAL_SIMULATION_H
+#define INCREMENTAL_SIMULATION_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "Process.h"
+#include "ProcessGrantInfo.h"
+#include "Segment.h"
+#include "SchedulerRegistry.h"
+#include "SimulationSnapshot.h"
+
+// Keeps one algorithm's schedule up to date while its workload is edited.
+//
+// The run records a checkpoint every `interval` time units. Editing,
+// adding or removing a process that arrives at time C cannot affect
+// anything before C, so the next run resumes from the last checkpoint at
+// or before C instead of from time 0. Checkpoints after C are re-recorded
+// on the way.
+//
+// Only the policy-* algorithms can be resumed; the others are simply run
+// again from the start after every edit.
+class IncrementalSimulation {
+private:
+    std::string algorithm;
+    SchedulerParams params;
+    bool resumable = false;
+    int checkpoint_limit;
+
+    std::shared_ptr<const std::vector<Process>> processes;
+    std::shared_ptr<const std::vector<int>> order;   // arrival_order_of(*processes)
+    std::vector<SimulationSnapshot> checkpoints;     // checkpoints[k] paused at k * interval
+    SimTime interval = SimTime(1);
+    SimTime resumed_at{};
+
+    ScheduleCollector output;
+
+    bool run_from(size_t checkpoint, std::string& error);
+    bool apply(std::vector<Process> edited, std::vector<int> edited_order, SimTime change_time, std::string& error);
+
+public:
+    explicit IncrementalSimulation(int checkpoint_count = 16);
+
+    // Runs the algorithm over a new workload from time 0
+    bool start(const std::string& algorithm_name, const SchedulerParams& algorithm_params,
+               std::vector<Process> workload, std::string& error);
+    bool started() const { return processes != nullptr; }
+
+    // Edits re-run only what follows the change; all return false with a
+    // message for a bad index or if the algorithm fails
+    bool replace(size_t index, const Process& process, std::string& error);
+    bool add(const Process& process, std::string& error);
+    bool remove(size_t index, std::string& error);
+
+    // Diffs against the current workload by position and re-runs from the
+    // earliest arrival among the processes that changed
+    bool update(std::vector<Process> workload, std::string& error);
+
+    const std::string& algorithm_name() const { return algorithm; }
+    const SchedulerParams& algorithm_params() const { return params; }
+    const std::vector<Process>& workload() const { return *processes; }
+    const std::vector<ProcessGrantInfo>& records() const { return output.records; }
+    const SegmentTable& segments() const { return output.slices; }
+    const std::vector<ProcessCounters>& counters() const { return output.process_counters; }
+    const RunCounters& run_counters() const { return output.run_counters; }
+
+    // Time the most recent run started from (0 for a full run)
+    SimTime resumed_from() const { return resumed_at; }
+    size_t checkpoint_count() const { return checkpoints.size(); }
+};
+
+#endif
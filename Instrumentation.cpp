@@ -0,0 +1,116 @@
+#include "Instrumentation.h"
+
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#ifdef SCHED_INSTRUMENT
+
+namespace {
+
+// Blocks of every thread that has recorded anything. They outlive their
+// threads so that a report after a worker pool has joined still sees them.
+struct BlockList {
+    std::mutex lock;
+    std::vector<std::unique_ptr<InstrumentBlock>> blocks;
+};
+
+BlockList& block_list() {
+    static BlockList list;
+    return list;
+}
+
+}  // namespace
+
+InstrumentBlock& instrument_block() {
+    // A plain pointer needs no TLS guard, unlike a thread_local object
+    thread_local InstrumentBlock* block = nullptr;
+    if (block == nullptr) {
+        BlockList& list = block_list();
+        std::lock_guard<std::mutex> guard(list.lock);
+        list.blocks.push_back(std::make_unique<InstrumentBlock>());
+        block = list.blocks.back().get();
+    }
+    return *block;
+}
+
+InstrumentationReport instrumentation_report() {
+    InstrumentationReport report;
+    BlockList& list = block_list();
+    std::lock_guard<std::mutex> guard(list.lock);
+    for (const auto& b : list.blocks) {
+        for (size_t s = 0; s < kStageCount; s++) {
+            report.stages[s].calls += b->calls[s].load(std::memory_order_relaxed);
+            report.stages[s].nanoseconds += b->nanoseconds[s].load(std::memory_order_relaxed);
+        }
+        for (size_t c = 0; c < kInstrumentCounterCount; c++) {
+            report.counters[c] += b->counters[c].load(std::memory_order_relaxed);
+        }
+    }
+    return report;
+}
+
+void reset_instrumentation() {
+    BlockList& list = block_list();
+    std::lock_guard<std::mutex> guard(list.lock);
+    for (const auto& b : list.blocks) {
+        for (auto& v : b->calls) v.store(0, std::memory_order_relaxed);
+        for (auto& v : b->nanoseconds) v.store(0, std::memory_order_relaxed);
+        for (auto& v : b->counters) v.store(0, std::memory_order_relaxed);
+    }
+}
+
+#else
+
+InstrumentationReport instrumentation_report() {
+    return InstrumentationReport();
+}
+
+void reset_instrumentation() {}
+
+#endif
+
+const char* stage_name(Stage stage) {
+    switch (stage) {
+        case Stage::Run: return "run";
+        case Stage::Arrival: return "arrival";
+        case Stage::QueuePush: return "queue_push";
+        case Stage::QueuePop: return "queue_pop";
+        case Stage::Dispatch: return "dispatch";
+        case Stage::ChartEmit: return "chart_emit";
+        case Stage::Analysis: return "analysis";
+        default: return "?";
+    }
+}
+
+const char* instrument_counter_name(InstrumentCounter counter) {
+    switch (counter) {
+        case InstrumentCounter::Events: return "events";
+        case InstrumentCounter::SegmentsMerged: return "segments_merged";
+        case InstrumentCounter::IoCompletions: return "io_completions";
+        case InstrumentCounter::QuantumExpiries: return "quantum_expiries";
+        default: return "?";
+    }
+}
+
+void print_instrumentation(std::ostream& out, const InstrumentationReport& report) {
+    if (!instrumentation_enabled()) {
+        out << "instrumentation compiled out (configure with -DSCHED_INSTRUMENT=ON)\n";
+        return;
+    }
+    std::ios_base::fmtflags flags = out.flags();
+    out << std::left << std::setw(18) << "stage" << std::right << std::setw(14) << "calls" << std::setw(16)
+        << "total_ms" << std::setw(16) << "ns/call" << "\n";
+    for (size_t s = 0; s < kStageCount; s++) {
+        const StageStats& st = report.stages[s];
+        out << std::left << std::setw(18) << stage_name((Stage)s) << std::right << std::setw(14) << st.calls
+            << std::setw(16) << std::fixed << std::setprecision(3) << st.nanoseconds / 1e6 << std::setw(16)
+            << std::setprecision(1) << (st.calls > 0 ? (double)st.nanoseconds / st.calls : 0.0) << "\n";
+    }
+    for (size_t c = 0; c < kInstrumentCounterCount; c++) {
+        out << std::left << std::setw(18) << instrument_counter_name((InstrumentCounter)c) << std::right
+            << std::setw(14) << report.counters[c] << "\n";
+    }
+    out.flags(flags);
+}
@@ -0,0 +1,121 @@
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+// Where a run spends its time, for profiling the simulator itself on large
+// traces. Built only with -DSCHED_INSTRUMENT=ON (which defines
+// SCHED_INSTRUMENT); otherwise the macros below expand to nothing and the
+// hot paths are exactly as without them.
+//
+//   SCHED_TIME_SCOPE(Stage::Dispatch);        // times the rest of the block
+//   SCHED_COUNT(InstrumentCounter::...);       // bumps a plain counter
+//
+// Each thread records into its own block; instrumentation_report() sums
+// them. Stage times are inclusive: Dispatch contains its QueuePop, Run
+// contains everything the engine does.
+
+enum class Stage {
+    Run,         // One scheduler run, from the registry call to the chart
+    Arrival,     // Admitting an arriving process
+    QueuePush,   // Ready-queue insert
+    QueuePop,    // Ready-queue removal of the next task
+    Dispatch,    // Picking the next task and fixing its slice
+    ChartEmit,   // Appending segments and building the final chart
+    Analysis,    // GranttAnalysis aggregation and metrics
+    Count
+};
+
+enum class InstrumentCounter {
+    Events,            // Event times the engine stopped at
+    SegmentsMerged,    // Slices folded into the previous segment
+    IoCompletions,
+    QuantumExpiries,   // Slices that ended with work left
+    Count
+};
+
+constexpr size_t kStageCount = (size_t)Stage::Count;
+constexpr size_t kInstrumentCounterCount = (size_t)InstrumentCounter::Count;
+
+struct StageStats {
+    uint64_t calls = 0;
+    uint64_t nanoseconds = 0;
+};
+
+struct InstrumentationReport {
+    std::array<StageStats, kStageCount> stages{};
+    std::array<uint64_t, kInstrumentCounterCount> counters{};
+};
+
+const char* stage_name(Stage stage);
+const char* instrument_counter_name(InstrumentCounter counter);
+
+constexpr bool instrumentation_enabled() {
+#ifdef SCHED_INSTRUMENT
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Totals over every thread since the last reset; all zero when compiled out
+InstrumentationReport instrumentation_report();
+void reset_instrumentation();
+
+// One line per stage (calls, total ms, ns per call) and per counter
+void print_instrumentation(std::ostream& out, const InstrumentationReport& report);
+
+#ifdef SCHED_INSTRUMENT
+
+// One thread's totals. Only the owning thread writes, so relaxed loads and
+// stores suffice; the atomics only keep concurrent reports well-defined.
+// Cache-line aligned so that threads never write to a shared line.
+struct alignas(64) InstrumentBlock {
+    std::array<std::atomic<uint64_t>, kStageCount> calls{};
+    std::array<std::atomic<uint64_t>, kStageCount> nanoseconds{};
+    std::array<std::atomic<uint64_t>, kInstrumentCounterCount> counters{};
+
+    static void bump(std::atomic<uint64_t>& v, uint64_t by) {
+        v.store(v.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+    }
+};
+
+// The calling thread's block, registered on first use
+InstrumentBlock& instrument_block();
+
+class StageTimer {
+private:
+    Stage stage;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    explicit StageTimer(Stage s) : stage(s), start(std::chrono::steady_clock::now()) {}
+    ~StageTimer() {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        InstrumentBlock& block = instrument_block();
+        InstrumentBlock::bump(block.calls[(size_t)stage], 1);
+        InstrumentBlock::bump(block.nanoseconds[(size_t)stage],
+                              (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+
+    StageTimer(const StageTimer&) = delete;
+    StageTimer& operator=(const StageTimer&) = delete;
+};
+
+#define SCHED_INSTRUMENT_CONCAT2(a, b) a##b
+#define SCHED_INSTRUMENT_CONCAT(a, b) SCHED_INSTRUMENT_CONCAT2(a, b)
+#define SCHED_TIME_SCOPE(stage) StageTimer SCHED_INSTRUMENT_CONCAT(sched_stage_timer_, __LINE__)(stage)
+#define SCHED_COUNT(counter) InstrumentBlock::bump(instrument_block().counters[(size_t)(counter)], 1)
+
+#else
+
+#define SCHED_TIME_SCOPE(stage) ((void)0)
+#define SCHED_COUNT(counter) ((void)0)
+
+#endif
+
+#endif
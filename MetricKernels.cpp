@@ -0,0 +1,456 @@
+#include "MetricKernels.h"
+
+#include <algorithm>
+#include <atomic>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define SCHED_METRIC_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// Scalar versions; the vector versions use these for their tails
+// ---------------------------------------------------------------------------
+
+void sum_scalar(const int64_t* v, size_t n, TimeSum& sum) {
+    for (size_t i = 0; i < n; i++) sum.add(v[i]);
+}
+
+void min_max_scalar(const int64_t* v, size_t n, int64_t& lowest, int64_t& highest) {
+    for (size_t i = 0; i < n; i++) {
+        lowest = std::min(lowest, v[i]);
+        highest = std::max(highest, v[i]);
+    }
+}
+
+// Column sums; the totals are differences of these
+struct ColumnSums {
+    TimeSum arrival;
+    TimeSum burst;
+    TimeSum start;
+    TimeSum end;
+    int64_t last_end = std::numeric_limits<int64_t>::min();
+};
+
+void sums_scalar(const MetricColumns& c, size_t from, ColumnSums& s) {
+    for (size_t i = from; i < c.size(); i++) {
+        s.arrival.add(c.arrival[i]);
+        s.burst.add(c.burst[i]);
+        s.start.add(c.start[i]);
+        s.end.add(c.end[i]);
+        s.last_end = std::max(s.last_end, c.end[i]);
+    }
+}
+
+// Differences wrap like the vector lanes do instead of overflowing
+int64_t wrap_sub(int64_t a, int64_t b) { return (int64_t)((uint64_t)a - (uint64_t)b); }
+
+void derive_scalar(const MetricColumns& c, size_t from, int64_t* response, int64_t* turnaround, int64_t* waiting) {
+    for (size_t i = from; i < c.size(); i++) {
+        response[i] = wrap_sub(c.start[i], c.arrival[i]);
+        turnaround[i] = wrap_sub(c.end[i], c.arrival[i]);
+        waiting[i] = wrap_sub(turnaround[i], c.burst[i]);
+    }
+}
+
+int bucket_scalar(int64_t value, int64_t lowest, int64_t width, int last) {
+    if (value < lowest) return 0;
+    uint64_t d = (uint64_t)value - (uint64_t)lowest;
+    return (int)std::min<uint64_t>(d / (uint64_t)width, (uint64_t)last);
+}
+
+void buckets_scalar(const int64_t* v, size_t n, int64_t lowest, int64_t width, int last, int* out) {
+    for (size_t i = 0; i < n; i++) out[i] = bucket_scalar(v[i], lowest, width, last);
+}
+
+#ifdef SCHED_METRIC_X86
+
+// Exact lane sums: each value is split into its unsigned 32-bit halves
+// and its sign, which add up without overflow for fewer than 2^32 values
+// per lane; value = high * 2^32 + low - 2^64 * negative
+struct SplitSum {
+    uint64_t low = 0;
+    uint64_t high = 0;
+    uint64_t negative = 0;
+
+    void into(TimeSum& sum) const {
+        sum.add_unsigned(low);
+        sum += TimeSum((int64_t)(high >> 32), high << 32);
+        sum -= TimeSum((int64_t)negative, 0);
+    }
+};
+
+// ---------------------------------------------------------------------------
+// AVX2: 4 lanes
+// ---------------------------------------------------------------------------
+
+struct Split256 {
+    __m256i low, high, negative;
+};
+
+__attribute__((target("avx2"))) inline Split256 split_zero() {
+    return {_mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256()};
+}
+
+__attribute__((target("avx2"))) inline void split_add(Split256& acc, __m256i v) {
+    acc.low = _mm256_add_epi64(acc.low, _mm256_and_si256(v, _mm256_set1_epi64x(0xFFFFFFFF)));
+    acc.high = _mm256_add_epi64(acc.high, _mm256_srli_epi64(v, 32));
+    acc.negative = _mm256_sub_epi64(acc.negative, _mm256_cmpgt_epi64(_mm256_setzero_si256(), v));
+}
+
+__attribute__((target("avx2"))) inline void split_into(const Split256& acc, TimeSum& sum) {
+    alignas(32) uint64_t low[4], high[4], negative[4];
+    _mm256_store_si256((__m256i*)low, acc.low);
+    _mm256_store_si256((__m256i*)high, acc.high);
+    _mm256_store_si256((__m256i*)negative, acc.negative);
+    for (int k = 0; k < 4; k++) SplitSum{low[k], high[k], negative[k]}.into(sum);
+}
+
+__attribute__((target("avx2"))) inline __m256i min64(__m256i a, __m256i b) {
+    return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b));
+}
+
+__attribute__((target("avx2"))) inline __m256i max64(__m256i a, __m256i b) {
+    return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b));
+}
+
+__attribute__((target("avx2"))) inline int64_t horizontal(__m256i v, bool want_max) {
+    alignas(32) int64_t lanes[4];
+    _mm256_store_si256((__m256i*)lanes, v);
+    return want_max ? *std::max_element(lanes, lanes + 4) : *std::min_element(lanes, lanes + 4);
+}
+
+__attribute__((target("avx2"))) TimeSum sum_avx2(const int64_t* v, size_t n) {
+    Split256 acc = split_zero();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) split_add(acc, _mm256_loadu_si256((const __m256i*)(v + i)));
+    TimeSum sum;
+    split_into(acc, sum);
+    sum_scalar(v + i, n - i, sum);
+    return sum;
+}
+
+__attribute__((target("avx2"))) void min_max_avx2(const int64_t* v, size_t n, int64_t& lowest, int64_t& highest) {
+    size_t i = 0;
+    if (n >= 4) {
+        __m256i mn = _mm256_set1_epi64x(lowest), mx = _mm256_set1_epi64x(highest);
+        for (; i + 4 <= n; i += 4) {
+            __m256i x = _mm256_loadu_si256((const __m256i*)(v + i));
+            mn = min64(mn, x);
+            mx = max64(mx, x);
+        }
+        lowest = horizontal(mn, false);
+        highest = horizontal(mx, true);
+    }
+    min_max_scalar(v + i, n - i, lowest, highest);
+}
+
+__attribute__((target("avx2"))) ColumnSums sums_avx2(const MetricColumns& c) {
+    Split256 a = split_zero(), b = split_zero(), s = split_zero(), e = split_zero();
+    __m256i last = _mm256_set1_epi64x(std::numeric_limits<int64_t>::min());
+    const size_t n = c.size();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i end = _mm256_loadu_si256((const __m256i*)(c.end.data() + i));
+        split_add(a, _mm256_loadu_si256((const __m256i*)(c.arrival.data() + i)));
+        split_add(b, _mm256_loadu_si256((const __m256i*)(c.burst.data() + i)));
+        split_add(s, _mm256_loadu_si256((const __m256i*)(c.start.data() + i)));
+        split_add(e, end);
+        last = max64(last, end);
+    }
+    ColumnSums sums;
+    split_into(a, sums.arrival);
+    split_into(b, sums.burst);
+    split_into(s, sums.start);
+    split_into(e, sums.end);
+    sums.last_end = horizontal(last, true);
+    sums_scalar(c, i, sums);
+    return sums;
+}
+
+__attribute__((target("avx2"))) void derive_avx2(const MetricColumns& c, int64_t* response, int64_t* turnaround,
+                                                  int64_t* waiting) {
+    const size_t n = c.size();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i a = _mm256_loadu_si256((const __m256i*)(c.arrival.data() + i));
+        __m256i t = _mm256_sub_epi64(_mm256_loadu_si256((const __m256i*)(c.end.data() + i)), a);
+        __m256i r = _mm256_sub_epi64(_mm256_loadu_si256((const __m256i*)(c.start.data() + i)), a);
+        __m256i w = _mm256_sub_epi64(t, _mm256_loadu_si256((const __m256i*)(c.burst.data() + i)));
+        _mm256_storeu_si256((__m256i*)(response + i), r);
+        _mm256_storeu_si256((__m256i*)(turnaround + i), t);
+        _mm256_storeu_si256((__m256i*)(waiting + i), w);
+    }
+    derive_scalar(c, i, response, turnaround, waiting);
+}
+
+// Buckets of 4 values. Offsets from `lowest` at or beyond the last bucket
+// are clamped before the conversion to double, so the offsets converted
+// stay below 2^52 and convert exactly with the 2^52 bit trick. The
+// quotient is then off by at most one, which the multiply-back corrects.
+__attribute__((target("avx2"))) void buckets_avx2(const int64_t* v, size_t n, int64_t lowest, int64_t width, int last,
+                                                   int* out) {
+    const uint64_t limit = ((uint64_t)last + 1) * (uint64_t)width;   // First offset past the last bucket
+    const __m256i lo = _mm256_set1_epi64x(lowest);
+    const __m256i sign = _mm256_set1_epi64x(std::numeric_limits<int64_t>::min());
+    const __m256i beyond = _mm256_xor_si256(_mm256_set1_epi64x((int64_t)(limit - 1)), sign);
+    const __m256i exponent = _mm256_set1_epi64x(0x4330000000000000);
+    const __m256d two52 = _mm256_set1_pd(4503599627370496.0);
+    const __m256d w = _mm256_set1_pd((double)width), top = _mm256_set1_pd(last), zero = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(v + i));
+        __m256i below = _mm256_cmpgt_epi64(lo, x);
+        __m256i d = _mm256_sub_epi64(x, lo);
+        __m256i over = _mm256_andnot_si256(below, _mm256_cmpgt_epi64(_mm256_xor_si256(d, sign), beyond));
+        d = _mm256_andnot_si256(_mm256_or_si256(below, over), d);
+        __m256d offset = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(d, exponent)), two52);
+        __m256d q = _mm256_floor_pd(_mm256_div_pd(offset, w));
+        q = _mm256_sub_pd(q, _mm256_and_pd(_mm256_cmp_pd(_mm256_mul_pd(q, w), offset, _CMP_GT_OQ), _mm256_set1_pd(1)));
+        q = _mm256_min_pd(_mm256_max_pd(q, zero), top);
+        q = _mm256_blendv_pd(q, top, _mm256_castsi256_pd(over));
+        _mm_storeu_si128((__m128i*)(out + i), _mm256_cvttpd_epi32(q));
+    }
+    buckets_scalar(v + i, n - i, lowest, width, last, out + i);
+}
+
+// ---------------------------------------------------------------------------
+// AVX-512: 8 lanes; buckets reuse the AVX2 version
+// ---------------------------------------------------------------------------
+
+struct Split512 {
+    __m512i low, high, negative;
+};
+
+__attribute__((target("avx512f"))) inline Split512 split_zero512() {
+    return {_mm512_setzero_si512(), _mm512_setzero_si512(), _mm512_setzero_si512()};
+}
+
+// The unmasked shift/min/max intrinsics merge into GCC's self-initialized
+// "undefined" vector, which -Wuninitialized flags; the zero-masked forms
+// with every lane selected compile to the same instructions
+constexpr __mmask8 kAllLanes = 0xFF;
+
+__attribute__((target("avx512f"))) inline __m512i min64(__m512i a, __m512i b) {
+    return _mm512_maskz_min_epi64(kAllLanes, a, b);
+}
+
+__attribute__((target("avx512f"))) inline __m512i max64(__m512i a, __m512i b) {
+    return _mm512_maskz_max_epi64(kAllLanes, a, b);
+}
+
+__attribute__((target("avx512f"))) inline int64_t horizontal(__m512i v, bool want_max) {
+    alignas(64) int64_t lanes[8];
+    _mm512_store_si512(lanes, v);
+    return want_max ? *std::max_element(lanes, lanes + 8) : *std::min_element(lanes, lanes + 8);
+}
+
+__attribute__((target("avx512f"))) inline void split_add(Split512& acc, __m512i v) {
+    acc.low = _mm512_add_epi64(acc.low, _mm512_and_si512(v, _mm512_set1_epi64(0xFFFFFFFF)));
+    acc.high = _mm512_add_epi64(acc.high, _mm512_maskz_srli_epi64(kAllLanes, v, 32));
+    acc.negative = _mm512_add_epi64(acc.negative, _mm512_maskz_srli_epi64(kAllLanes, v, 63));
+}
+
+__attribute__((target("avx512f"))) inline void split_into(const Split512& acc, TimeSum& sum) {
+    alignas(64) uint64_t low[8], high[8], negative[8];
+    _mm512_store_si512(low, acc.low);
+    _mm512_store_si512(high, acc.high);
+    _mm512_store_si512(negative, acc.negative);
+    for (int k = 0; k < 8; k++) SplitSum{low[k], high[k], negative[k]}.into(sum);
+}
+
+__attribute__((target("avx512f"))) TimeSum sum_avx512(const int64_t* v, size_t n) {
+    Split512 acc = split_zero512();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) split_add(acc, _mm512_loadu_si512(v + i));
+    TimeSum sum;
+    split_into(acc, sum);
+    sum_scalar(v + i, n - i, sum);
+    return sum;
+}
+
+__attribute__((target("avx512f"))) void min_max_avx512(const int64_t* v, size_t n, int64_t& lowest,
+                                                        int64_t& highest) {
+    size_t i = 0;
+    if (n >= 8) {
+        __m512i mn = _mm512_set1_epi64(lowest), mx = _mm512_set1_epi64(highest);
+        for (; i + 8 <= n; i += 8) {
+            __m512i x = _mm512_loadu_si512(v + i);
+            mn = min64(mn, x);
+            mx = max64(mx, x);
+        }
+        lowest = horizontal(mn, false);
+        highest = horizontal(mx, true);
+    }
+    min_max_scalar(v + i, n - i, lowest, highest);
+}
+
+__attribute__((target("avx512f"))) ColumnSums sums_avx512(const MetricColumns& c) {
+    Split512 a = split_zero512(), b = split_zero512(), s = split_zero512(), e = split_zero512();
+    __m512i last = _mm512_set1_epi64(std::numeric_limits<int64_t>::min());
+    const size_t n = c.size();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512i end = _mm512_loadu_si512(c.end.data() + i);
+        split_add(a, _mm512_loadu_si512(c.arrival.data() + i));
+        split_add(b, _mm512_loadu_si512(c.burst.data() + i));
+        split_add(s, _mm512_loadu_si512(c.start.data() + i));
+        split_add(e, end);
+        last = max64(last, end);
+    }
+    ColumnSums sums;
+    split_into(a, sums.arrival);
+    split_into(b, sums.burst);
+    split_into(s, sums.start);
+    split_into(e, sums.end);
+    sums.last_end = horizontal(last, true);
+    sums_scalar(c, i, sums);
+    return sums;
+}
+
+__attribute__((target("avx512f"))) void derive_avx512(const MetricColumns& c, int64_t* response, int64_t* turnaround,
+                                                       int64_t* waiting) {
+    const size_t n = c.size();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512i a = _mm512_loadu_si512(c.arrival.data() + i);
+        __m512i t = _mm512_sub_epi64(_mm512_loadu_si512(c.end.data() + i), a);
+        __m512i r = _mm512_sub_epi64(_mm512_loadu_si512(c.start.data() + i), a);
+        __m512i w = _mm512_sub_epi64(t, _mm512_loadu_si512(c.burst.data() + i));
+        _mm512_storeu_si512(response + i, r);
+        _mm512_storeu_si512(turnaround + i, t);
+        _mm512_storeu_si512(waiting + i, w);
+    }
+    derive_scalar(c, i, response, turnaround, waiting);
+}
+
+#endif  // SCHED_METRIC_X86
+
+MetricIsa detect_isa() {
+#ifdef SCHED_METRIC_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return MetricIsa::Avx512;
+    if (__builtin_cpu_supports("avx2")) return MetricIsa::Avx2;
+#endif
+    return MetricIsa::Scalar;
+}
+
+const MetricIsa supported_isa = detect_isa();
+std::atomic<MetricIsa> active_isa(supported_isa);
+
+}  // namespace
+
+MetricIsa metric_isa() {
+    return active_isa.load(std::memory_order_relaxed);
+}
+
+MetricIsa force_metric_isa(MetricIsa isa) {
+    isa = std::min(isa, supported_isa);
+    active_isa.store(isa, std::memory_order_relaxed);
+    return isa;
+}
+
+const char* metric_isa_name(MetricIsa isa) {
+    switch (isa) {
+        case MetricIsa::Avx512: return "avx512";
+        case MetricIsa::Avx2: return "avx2";
+        default: return "scalar";
+    }
+}
+
+TimeSum metric_sum(const int64_t* values, size_t n) {
+#ifdef SCHED_METRIC_X86
+    switch (metric_isa()) {
+        case MetricIsa::Avx512: return sum_avx512(values, n);
+        case MetricIsa::Avx2: return sum_avx2(values, n);
+        default: break;
+    }
+#endif
+    TimeSum sum;
+    sum_scalar(values, n, sum);
+    return sum;
+}
+
+void metric_min_max(const int64_t* values, size_t n, int64_t& lowest, int64_t& highest) {
+    if (n == 0) return;
+    lowest = highest = values[0];
+#ifdef SCHED_METRIC_X86
+    switch (metric_isa()) {
+        case MetricIsa::Avx512: return min_max_avx512(values, n, lowest, highest);
+        case MetricIsa::Avx2: return min_max_avx2(values, n, lowest, highest);
+        default: break;
+    }
+#endif
+    min_max_scalar(values, n, lowest, highest);
+}
+
+MetricTotals metric_totals(const MetricColumns& columns) {
+    ColumnSums s;
+#ifdef SCHED_METRIC_X86
+    switch (metric_isa()) {
+        case MetricIsa::Avx512: s = sums_avx512(columns); break;
+        case MetricIsa::Avx2: s = sums_avx2(columns); break;
+        default: sums_scalar(columns, 0, s); break;
+    }
+#else
+    sums_scalar(columns, 0, s);
+#endif
+    MetricTotals totals;
+    totals.response = s.start - s.arrival;
+    totals.turnaround = s.end - s.arrival;
+    totals.waiting = totals.turnaround - s.burst;
+    totals.burst = s.burst;
+    totals.last_end = SimTime(columns.size() > 0 ? s.last_end : 0);
+    return totals;
+}
+
+void derive_metrics(const MetricColumns& columns, int64_t* response, int64_t* turnaround, int64_t* waiting) {
+#ifdef SCHED_METRIC_X86
+    switch (metric_isa()) {
+        case MetricIsa::Avx512: return derive_avx512(columns, response, turnaround, waiting);
+        case MetricIsa::Avx2: return derive_avx2(columns, response, turnaround, waiting);
+        default: break;
+    }
+#endif
+    derive_scalar(columns, 0, response, turnaround, waiting);
+}
+
+void metric_histogram(const int64_t* values, size_t n, int64_t lowest, int64_t width, std::vector<uint64_t>& counts) {
+    if (counts.empty() || width <= 0) return;
+    const int last = (int)counts.size() - 1;
+
+    // The vector version needs every in-range offset below 2^52
+    bool vector_ok = ((uint64_t)last + 1) <= ((uint64_t)1 << 52) / (uint64_t)width;
+
+    // Bucket indices a block at a time, then counted; four interleaved
+    // tables keep repeated buckets from serializing on one counter
+    constexpr size_t block = 1024;
+    int index[block];
+    std::vector<uint64_t> tables(counts.size() * 4, 0);
+    for (size_t from = 0; from < n; from += block) {
+        size_t len = std::min(block, n - from);
+#ifdef SCHED_METRIC_X86
+        if (vector_ok && metric_isa() != MetricIsa::Scalar) {
+            buckets_avx2(values + from, len, lowest, width, last, index);
+        } else {
+            buckets_scalar(values + from, len, lowest, width, last, index);
+        }
+#else
+        (void)vector_ok;
+        buckets_scalar(values + from, len, lowest, width, last, index);
+#endif
+        size_t i = 0;
+        for (; i + 4 <= len; i += 4) {
+            tables[index[i] * 4]++;
+            tables[index[i + 1] * 4 + 1]++;
+            tables[index[i + 2] * 4 + 2]++;
+            tables[index[i + 3] * 4 + 3]++;
+        }
+        for (; i < len; i++) tables[index[i] * 4]++;
+    }
+    for (size_t b = 0; b < counts.size(); b++) {
+        counts[b] += tables[b * 4] + tables[b * 4 + 1] + tables[b * 4 + 2] + tables[b * 4 + 3];
+    }
+}
@@ -0,0 +1,70 @@
+#ifndef METRIC_KERNELS_H
+#define METRIC_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "SimTime.h"
+
+// Reductions behind the schedule metrics, over plain tick columns
+// (SimTime::ticks()) so that they vectorize. Each kernel has a scalar version and, on x86 with GCC or
+// Clang, AVX2 and AVX-512 versions; the widest one the CPU supports is
+// picked on first use. All versions give identical results, and sums are
+// exact (see TimeSum) however large the times.
+
+// Per-process times, one entry per process in every column
+struct MetricColumns {
+    std::vector<int64_t> arrival;
+    std::vector<int64_t> burst;   // Total CPU time (both bursts)
+    std::vector<int64_t> start;   // First time on the CPU
+    std::vector<int64_t> end;     // Completion
+
+    size_t size() const { return arrival.size(); }
+    void reserve(size_t n) {
+        arrival.reserve(n);
+        burst.reserve(n);
+        start.reserve(n);
+        end.reserve(n);
+    }
+    void push_back(SimTime arrival_time, SimTime burst_time, SimTime start_time, SimTime end_time) {
+        arrival.push_back(arrival_time.ticks());
+        burst.push_back(burst_time.ticks());
+        start.push_back(start_time.ticks());
+        end.push_back(end_time.ticks());
+    }
+};
+
+// Sums over the columns in one pass. Response is start - arrival,
+// turnaround end - arrival and waiting turnaround - burst.
+struct MetricTotals {
+    TimeSum response;
+    TimeSum turnaround;
+    TimeSum waiting;
+    TimeSum burst;
+    SimTime last_end{};     // Latest completion, or 0 for no processes
+};
+
+enum class MetricIsa { Scalar, Avx2, Avx512 };
+
+TimeSum metric_sum(const int64_t* values, size_t n);
+
+// Smallest and largest value; both are left alone when n is 0
+void metric_min_max(const int64_t* values, size_t n, int64_t& lowest, int64_t& highest);
+
+MetricTotals metric_totals(const MetricColumns& columns);
+
+// Fills the per-process response, turnaround and waiting times; each
+// output holds columns.size() entries
+void derive_metrics(const MetricColumns& columns, int64_t* response, int64_t* turnaround, int64_t* waiting);
+
+// Adds values to counts.size() buckets of `width` starting at `lowest`;
+// values outside the range go to the first or last bucket
+void metric_histogram(const int64_t* values, size_t n, int64_t lowest, int64_t width, std::vector<uint64_t>& counts);
+
+// Kernels in use; force_metric_isa() caps them (e.g. at Scalar, to compare)
+// and returns what is actually used, never more than the CPU supports
+MetricIsa metric_isa();
+MetricIsa force_metric_isa(MetricIsa isa);
+const char* metric_isa_name(MetricIsa isa);
+
+#endif
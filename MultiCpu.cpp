@@ -0,0 +1,660 @@
+#include "MultiCpu.h"
+#include "SchedulerRegistry.h"
+#include "SimulationSnapshot.h"
+
+#include <algorithm>
+#include <climits>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <queue>
+#include <utility>
+
+namespace {
+
+constexpr SimTime never = kSimTimeMax;
+constexpr size_t no_segment = (size_t)-1;
+
+// Work is counted in thousandths of a tick at full local speed, so that a
+// slowed-down CPU still makes progress every tick
+constexpr int64_t kWork = 1000;
+
+// What gets dispatched: one thread (Independent) or a whole gang
+struct Unit {
+    int process = 0;
+    int width = 1;             // CPUs it holds while running
+    int threads = 1;           // Threads it stands for (at the barrier)
+    int64_t remaining = 0;     // Work per member
+    SimTime slice_start{};
+    int64_t speed = kWork;     // Work per tick in the current slice
+    SimTime slice_end{};
+    SimTime wake{};            // Of the slice: waiting for its CPUs to leave idle states
+    int pstate = -1;           // Of its CPUs in the current slice; -1 without an energy model
+    bool on_cpu = false;       // Heap entries of units not on a CPU are stale
+    std::vector<int> cpus;
+    std::vector<int> last_cpus;   // Of the previous slice of this burst
+};
+
+struct Job {
+    int phase = 0;               // 0 first burst, 1 I/O, 2 second burst, 3 done
+    int units_left = 0;          // Units of the current burst not yet finished
+    SimTime burst_start{};
+    SimTime finished_sum{};      // Thread-ticks from burst_start to each finished thread
+    int io_device = -1;
+    int home = -1;               // Memory's node; -1 until placed
+    int group = -1;              // Bandwidth group, -1 for none
+    bool pinned = false;         // Restricted to its affinity mask
+    int allowed = 0;             // CPUs of the machine in the mask, when pinned
+};
+
+// Bandwidth group during a run
+struct GroupState {
+    SimTime used{};              // CPU-ticks in the current period
+    SimTime period_end{};
+    int running = 0;             // CPUs held by its threads and its subgroups'
+    int ready_threads = 0;       // Its own threads waiting in the ready queue
+    bool throttled = false;
+};
+
+// How many entries of `now` have no match in `before`, comparing key(cpu)
+template <class Key>
+int moved(std::vector<int> before, std::vector<int> now, Key key) {
+    for (auto& c : before) c = key(c);
+    for (auto& c : now) c = key(c);
+    std::sort(before.begin(), before.end());
+    std::sort(now.begin(), now.end());
+    std::vector<int> diff;
+    std::set_difference(now.begin(), now.end(), before.begin(), before.end(), std::back_inserter(diff));
+    return (int)diff.size();
+}
+
+// State of one cpu_process() call
+class Run {
+private:
+    using Event = std::pair<SimTime, int>;
+    using EventHeap = std::priority_queue<Event, std::vector<Event>, std::greater<Event>>;
+
+    const std::vector<Process>& processes;
+    const MultiCpuOptions& options;
+    const CpuTopology& topology;
+    const CpuConstraints* constraints;    // Null for none
+    const EnergyModel* energy;            // Null for none
+
+    std::vector<Job> jobs;
+    std::vector<Unit> units;
+    std::vector<int> spare_units;         // Recycled entries of units
+    std::deque<int> ready;
+    EventHeap running;                    // (slice end, unit)
+    EventHeap io_done;                    // (time, process)
+    std::priority_queue<int, std::vector<int>, std::greater<int>> free_io_devices;
+    int io_devices_used = 0;
+    std::vector<int> cpu_unit;            // Unit on each CPU, -1 when idle
+    std::vector<size_t> last_segment;     // Latest segment on each CPU, for merging
+    std::vector<int> core_busy;           // Busy SMT siblings per core
+    std::vector<int> node_free;           // Free CPUs per node
+    int free_cpus = 0;
+    int completed = 0;
+    int next_home = 0;                    // NodeAffine round robin
+    SimTime interleaved_time{};           // CPU-ticks of threads with interleaved memory
+    std::vector<GroupState> groups;       // Parallel to constraints->groups
+    std::vector<SimTime> idle_since;      // Per CPU, with an energy model
+    double active_power = 0;              // Watts drawn by busy CPUs
+    long long ready_width = 0;            // CPUs wanted by the ready queue
+
+    int threads_of(int p) const { return std::max(processes[p].threads, 1); }
+
+    void emit(int row, int resource, SegmentKind kind, SimTime start, SimTime end, size_t* merge_slot) {
+        if (end <= start) return;
+        segments.end_time = std::max(segments.end_time, end);
+        if (merge_slot != nullptr && *merge_slot != no_segment) {
+            Segment& last = segments.segments[*merge_slot];
+            if (last.row == row && last.end == start) {
+                last.end = end;
+                return;
+            }
+        }
+        if (merge_slot != nullptr) *merge_slot = segments.segments.size();
+        segments.segments.push_back(Segment(row, resource, kind, start, end));
+    }
+
+    // CPU-ticks between two events
+    void account(SimTime from, SimTime to) {
+        SimTime span = to - from;
+        if (span <= SimTime(0)) return;
+        stats.busy_time += span * (options.cpus - free_cpus);
+        stats.idle_time += span * free_cpus;
+        if (free_cpus > 0 && !ready.empty()) stats.fragmented_time += span * free_cpus;
+        stats.active_energy += active_power * (double)span.ticks();
+        for (size_t g = 0; g < groups.size(); g++) {
+            groups[g].used += span * groups[g].running;
+            if (groups[g].ready_threads > 0 && throttled((int)g)) {
+                stats.throttled_time += span * groups[g].ready_threads;
+            }
+        }
+    }
+
+    // ---- Bandwidth groups ----
+
+    const CpuGroup& group_spec(int g) const { return constraints->groups[g]; }
+
+    // A group is held back when it or any ancestor is
+    bool throttled(int g) const {
+        for (; g >= 0; g = group_spec(g).parent) {
+            if (groups[g].throttled) return true;
+        }
+        return false;
+    }
+
+    // Counts CPUs taken (+) or given back (-) against a group and its ancestors
+    void add_running(int g, int cpus) {
+        for (; g >= 0; g = group_spec(g).parent) groups[g].running += cpus;
+    }
+
+    // Starts a new period once the current one is over
+    void refresh(int g, SimTime now) {
+        GroupState& state = groups[g];
+        const CpuGroup& spec = group_spec(g);
+        if (now < state.period_end) return;
+        state.used = SimTime(0);
+        state.throttled = false;
+        state.period_end = (now / spec.period + 1) * spec.period;
+    }
+
+    // When the next group runs out of quota or gets a new one
+    SimTime next_group_event(SimTime now) const {
+        SimTime next = never;
+        for (size_t g = 0; g < groups.size(); g++) {
+            const GroupState& state = groups[g];
+            const CpuGroup& spec = group_spec((int)g);
+            if (spec.quota == SimTime(0)) continue;
+            if (state.throttled) {
+                next = std::min(next, state.period_end);
+            } else if (state.running > 0) {
+                SimTime left = std::max<SimTime>(spec.quota - state.used, SimTime(0));
+                next = std::min({next, state.period_end, now + (left + SimTime(state.running - 1)) / state.running});
+            }
+        }
+        return next;
+    }
+
+    // New periods, then throttles every group over its quota and takes its
+    // threads off the CPUs
+    void enforce_quotas(SimTime now, std::vector<int>& requeue) {
+        for (size_t g = 0; g < groups.size(); g++) {
+            if (group_spec((int)g).quota == SimTime(0)) continue;
+            refresh((int)g, now);
+            GroupState& state = groups[g];
+            if (state.throttled || state.used < group_spec((int)g).quota) continue;
+            state.throttled = true;
+            stats.throttles++;
+            for (int c = 0; c < options.cpus; c++) {
+                int u = cpu_unit[c];
+                if (u < 0 || !in_group(jobs[units[u].process].group, (int)g)) continue;
+                end_slice(u, now, requeue);
+            }
+        }
+    }
+
+    bool in_group(int g, int ancestor) const {
+        for (; g >= 0; g = group_spec(g).parent) {
+            if (g == ancestor) return true;
+        }
+        return false;
+    }
+
+    // ---- Affinity ----
+
+    bool allowed(int p, int cpu) const {
+        return !jobs[p].pinned || constraints->affinity[p].contains(cpu);
+    }
+
+    int free_allowed(int p) const {
+        if (!jobs[p].pinned) return free_cpus;
+        int n = 0;
+        for (int c = 0; c < options.cpus; c++) {
+            if (cpu_unit[c] < 0 && allowed(p, c)) n++;
+        }
+        return n;
+    }
+
+    void enqueue(int u) {
+        ready.push_back(u);
+        ready_width += units[u].width;
+        int g = jobs[units[u].process].group;
+        if (g >= 0) groups[g].ready_threads += units[u].threads;
+    }
+
+    // Work per tick of a thread on `cpu` whose memory is on `home`
+    int64_t cpu_speed(int cpu, int home) const {
+        int nodes = topology.nodes();
+        if (nodes == 1 || options.remote_slowdown == 100) return kWork;
+        if (options.placement == MemoryPlacement::Interleave) {
+            // One page in `nodes` is local
+            return std::max<int64_t>(1, kWork * 100 * nodes / (100 + (int64_t)options.remote_slowdown * (nodes - 1)));
+        }
+        if (home < 0 || topology.cpus[cpu].node == home) return kWork;
+        return std::max<int64_t>(1, kWork * 100 / options.remote_slowdown);
+    }
+
+    // Lower is better: off the preferred node, then a busy sibling, then
+    // not the core's first thread
+    int cpu_cost(int c, int node) const {
+        const CpuTopology::Cpu& cpu = topology.cpus[c];
+        return (node >= 0 && cpu.node != node ? 4 : 0) + (core_busy[cpu.core] > 0 ? 2 : 0) + (cpu.sibling > 0 ? 1 : 0);
+    }
+
+    void pick_cpus(Unit& unit) {
+        const Job& job = jobs[unit.process];
+        int node = options.placement == MemoryPlacement::NodeAffine ? job.home : -1;
+        if (unit.width == 1) {
+            // The CPU it last ran on wins ties
+            int best = -1, best_cost = 0;
+            int last = unit.last_cpus.empty() ? -1 : unit.last_cpus[0];
+            for (int c = 0; c < options.cpus; c++) {
+                if (cpu_unit[c] >= 0 || !allowed(unit.process, c)) continue;
+                int cost = cpu_cost(c, node) * 2 + (c == last ? 0 : 1);
+                if (best < 0 || cost < best_cost) {
+                    best = c;
+                    best_cost = cost;
+                }
+            }
+            unit.cpus.push_back(best);
+            return;
+        }
+        // A gang stays together on the node with the most free CPUs
+        if (node < 0 && topology.nodes() > 1) {
+            node = (int)(std::max_element(node_free.begin(), node_free.end()) - node_free.begin());
+        }
+        std::vector<std::pair<int, int>> free;   // (cost, cpu)
+        for (int c = 0; c < options.cpus; c++) {
+            if (cpu_unit[c] < 0 && allowed(unit.process, c)) free.push_back({cpu_cost(c, node), c});
+        }
+        std::partial_sort(free.begin(), free.begin() + unit.width, free.end());
+        for (int i = 0; i < unit.width; i++) unit.cpus.push_back(free[i].second);
+    }
+
+    int new_unit(int p, int width, int threads, SimTime length) {
+        int u;
+        if (spare_units.empty()) {
+            u = (int)units.size();
+            units.emplace_back();
+        } else {
+            u = spare_units.back();
+            spare_units.pop_back();
+        }
+        Unit& unit = units[u];
+        unit.process = p;
+        unit.width = width;
+        unit.threads = threads;
+        unit.remaining = length.ticks() * kWork;
+        unit.cpus.clear();
+        unit.last_cpus.clear();
+        return u;
+    }
+
+    // Queues the units of burst `phase` (0 or 2) of process p
+    void start_burst(int p, int phase, SimTime now) {
+        Job& job = jobs[p];
+        const Process& process = processes[p];
+        job.phase = phase;
+        SimTime burst = phase == 0 ? process.cpu_burst_time1 : process.cpu_burst_time2;
+        if (burst <= SimTime(0)) {
+            if (phase == 0) {
+                chart[p].cpu_start_time1 = now;
+            } else {
+                chart[p].cpu_start_time2 = now;
+            }
+            finish_burst(p, now);
+            return;
+        }
+
+        if (options.placement == MemoryPlacement::NodeAffine && job.home < 0) {
+            job.home = next_home++ % topology.nodes();
+        }
+        int threads = threads_of(p);
+        job.burst_start = now;
+        job.finished_sum = SimTime(0);
+        if (options.allocation == CpuAllocation::Gang) {
+            int width = std::min(threads, job.pinned ? job.allowed : options.cpus);
+            int rounds = (threads + width - 1) / width;
+            stats.padding_time += burst * (width * rounds - threads);
+            enqueue(new_unit(p, width, threads, rounds * burst));
+            job.units_left = 1;
+        } else {
+            for (int t = 0; t < threads; t++) enqueue(new_unit(p, 1, 1, burst));
+            job.units_left = threads;
+        }
+    }
+
+    // The barrier of the current burst is reached: on to I/O or done
+    void finish_burst(int p, SimTime now) {
+        Job& job = jobs[p];
+        ProcessGrantInfo& info = chart[p];
+        const Process& process = processes[p];
+        if (job.phase == 0) {
+            info.cpu_end_time1 = now;
+            info.io_start_time = now;
+            job.phase = 1;
+            if (process.io_time > SimTime(0)) {
+                if (free_io_devices.empty()) free_io_devices.push(io_devices_used++);
+                job.io_device = free_io_devices.top();
+                free_io_devices.pop();
+                io_done.push({now + process.io_time, p});
+                return;
+            }
+            info.io_end_time = now;
+            start_burst(p, 2, now);
+            return;
+        }
+        info.cpu_end_time2 = now;
+        job.phase = 3;
+        completed++;
+    }
+
+    void unit_done(int u, SimTime now) {
+        Unit& unit = units[u];
+        int p = unit.process;
+        Job& job = jobs[p];
+        job.finished_sum += (now - job.burst_start) * unit.threads;
+        spare_units.push_back(u);
+        if (--job.units_left == 0) {
+            stats.barrier_wait_time += (now - job.burst_start) * threads_of(p) - job.finished_sum;
+            finish_burst(p, now);
+        }
+    }
+
+    void start(int u, SimTime now) {
+        Unit& unit = units[u];
+        pick_cpus(unit);
+        Job& job = jobs[unit.process];
+        if (options.placement == MemoryPlacement::FirstTouch && job.home < 0) {
+            job.home = topology.cpus[unit.cpus[0]].node;
+        }
+        unit.speed = kWork;
+        for (int c : unit.cpus) {
+            cpu_unit[c] = u;
+            core_busy[topology.cpus[c].core]++;
+            node_free[topology.cpus[c].node]--;
+            unit.speed = std::min(unit.speed, cpu_speed(c, job.home));
+        }
+        free_cpus -= unit.width;
+        add_running(job.group, unit.width);
+        stats.dispatches++;
+        unit.wake = SimTime(0);
+        if (energy != nullptr) {
+            // The gang waits for its slowest CPU to wake, and runs at one P-state
+            for (int c : unit.cpus) {
+                SimTime wake;
+                stats.idle_energy += energy->idle_energy(now - idle_since[c], wake);
+                if (wake > SimTime(0)) stats.wakeups++;
+                unit.wake = std::max(unit.wake, wake);
+            }
+            long long demand = (long long)(options.cpus - free_cpus) + ready_width;
+            unit.pstate = energy->pick_pstate(options.governor, demand, options.cpus);
+            const PState& pstate = energy->pstates[unit.pstate];
+            unit.speed = std::max<int64_t>(1, unit.speed * pstate.frequency / 100);
+            active_power += pstate.power * unit.width;
+        }
+        if (!unit.last_cpus.empty()) {
+            stats.migrations += moved(unit.last_cpus, unit.cpus, [](int c) { return c; });
+            stats.llc_migrations += moved(unit.last_cpus, unit.cpus, [&](int c) { return topology.cpus[c].llc; });
+            stats.node_migrations += moved(unit.last_cpus, unit.cpus, [&](int c) { return topology.cpus[c].node; });
+        }
+
+        ProcessGrantInfo& info = chart[unit.process];
+        if (job.phase == 0 && info.cpu_start_time1 < SimTime(0)) info.cpu_start_time1 = now;
+        if (job.phase == 2 && info.cpu_start_time2 < SimTime(0)) info.cpu_start_time2 = now;
+
+        SimTime slice((unit.remaining + unit.speed - 1) / unit.speed);
+        if (options.quantum > SimTime(0)) slice = std::min(slice, options.quantum);
+        unit.slice_start = now;
+        unit.slice_end = now + unit.wake + slice;
+        unit.on_cpu = true;
+        running.push({unit.slice_end, u});
+    }
+
+    void stop(int u, SimTime now) {
+        Unit& unit = units[u];
+        const Job& job = jobs[unit.process];
+        SimTime elapsed = now - unit.slice_start;
+        unit.on_cpu = false;
+        add_running(job.group, -unit.width);
+        int frequency = 100;
+        if (unit.pstate >= 0) {
+            const PState& pstate = energy->pstates[unit.pstate];
+            frequency = pstate.frequency;
+            active_power -= pstate.power * unit.width;
+        }
+        for (int c : unit.cpus) {
+            cpu_unit[c] = -1;
+            if (energy != nullptr) idle_since[c] = now;
+            core_busy[topology.cpus[c].core]--;
+            node_free[topology.cpus[c].node]++;
+            if (options.placement == MemoryPlacement::Interleave) {
+                interleaved_time += elapsed;
+            } else if (job.home >= 0 && topology.cpus[c].node != job.home) {
+                stats.remote_time += elapsed;
+            }
+            emit(unit.process, c, SegmentKind::Cpu, unit.slice_start, now, &last_segment[c]);
+        }
+        free_cpus += unit.width;
+        unit.last_cpus.swap(unit.cpus);
+        unit.cpus.clear();
+
+        // The last slice of a burst may not use its final tick in full.
+        // Time beyond nominal local speed is lost first to a lower
+        // frequency, the rest to remote memory.
+        SimTime woken = std::min(elapsed, unit.wake);
+        SimTime run = elapsed - woken;
+        int64_t done = std::min(unit.remaining, run.ticks() * unit.speed);
+        int64_t at_frequency = done * 100 / frequency;
+        unit.remaining -= done;
+        stats.wake_time += woken * unit.width;
+        stats.frequency_stall_time += SimTime((at_frequency - done) * unit.width / kWork);
+        stats.numa_stall_time += SimTime((run.ticks() * kWork - at_frequency) * unit.width / kWork);
+    }
+
+    // Takes a unit off its CPUs: done with its burst, or back in line later
+    void end_slice(int u, SimTime now, std::vector<int>& requeue) {
+        stop(u, now);
+        if (units[u].remaining == 0) {
+            unit_done(u, now);
+        } else {
+            requeue.push_back(u);
+        }
+    }
+
+    // Fills free CPUs in queue order. Units of throttled groups are passed
+    // over; so, with backfill, is a unit that does not fit.
+    void dispatch(SimTime now) {
+        while (free_cpus > 0 && !ready.empty()) {
+            size_t pick = ready.size();
+            for (size_t i = 0; i < ready.size(); i++) {
+                const Unit& unit = units[ready[i]];
+                const Job& job = jobs[unit.process];
+                if (job.group >= 0 && throttled(job.group)) continue;
+                if (unit.width <= free_allowed(unit.process)) {
+                    pick = i;
+                    break;
+                }
+                if (!options.backfill) break;
+            }
+            if (pick == ready.size()) break;
+            int u = ready[pick];
+            ready.erase(ready.begin() + (std::ptrdiff_t)pick);
+            ready_width -= units[u].width;
+            int g = jobs[units[u].process].group;
+            if (g >= 0) groups[g].ready_threads -= units[u].threads;
+            start(u, now);
+        }
+    }
+
+public:
+    std::vector<ProcessGrantInfo> chart;
+    SegmentTable segments;
+    MultiCpuStats stats;
+
+    Run(const std::vector<Process>& procs, const MultiCpuOptions& opts)
+        : processes(procs),
+          options(opts),
+          topology(opts.topology),
+          constraints(opts.constraints),
+          energy(opts.governor == FrequencyGovernor::None ? nullptr : &opts.energy) {}
+
+    void simulate() {
+        const int n = (int)processes.size();
+        std::vector<int> order = arrival_order_of(processes);
+        jobs.assign(n, Job());
+        chart.reserve(n);
+        segments.rows.reserve(n);
+        for (const auto& p : processes) {
+            const SimTime unset(-1);
+            chart.push_back(ProcessGrantInfo(p, unset, unset, unset, unset, unset, unset));
+            segments.rows.push_back(p.pid);
+        }
+        cpu_unit.assign(options.cpus, -1);
+        last_segment.assign(options.cpus, no_segment);
+        core_busy.assign(topology.cpus.back().core + 1, 0);
+        node_free.assign(topology.nodes(), 0);
+        for (const auto& cpu : topology.cpus) node_free[cpu.node]++;
+        free_cpus = options.cpus;
+        stats.cpus = options.cpus;
+        stats.nodes = topology.nodes();
+        stats.energy_model = energy != nullptr;
+        if (energy != nullptr) idle_since.assign(options.cpus, SimTime(0));
+        if (constraints != nullptr) {
+            groups.assign(constraints->groups.size(), GroupState());
+            for (int p = 0; p < n; p++) {
+                if ((size_t)p < constraints->group.size()) jobs[p].group = constraints->group[p];
+                if ((size_t)p >= constraints->affinity.size() || constraints->affinity[p].empty()) continue;
+                jobs[p].pinned = true;
+                jobs[p].allowed = constraints->affinity[p].count_below(options.cpus);
+            }
+        }
+
+        size_t next_arrival = 0;
+        SimTime last{};
+        std::vector<int> requeue;
+        while (completed < n) {
+            // Entries of units taken off early by a throttle are stale
+            while (!running.empty() && (!units[running.top().second].on_cpu ||
+                                        units[running.top().second].slice_end != running.top().first)) {
+                running.pop();
+            }
+            SimTime now = never;
+            if (next_arrival < order.size()) now = processes[order[next_arrival]].arrival_time;
+            if (!io_done.empty()) now = std::min(now, io_done.top().first);
+            if (!running.empty()) now = std::min(now, running.top().first);
+            if (!groups.empty()) now = std::min(now, next_group_event(last));
+            if (now == never) break;   // Only processes pinned off the machine are left
+            account(last, now);
+            last = now;
+
+            // 1. Slices end: a unit done with its burst, or out of quantum;
+            // then groups past their quota lose their CPUs
+            requeue.clear();
+            while (!running.empty() && running.top().first == now) {
+                int u = running.top().second;
+                running.pop();
+                if (units[u].on_cpu && units[u].slice_end == now) end_slice(u, now, requeue);
+            }
+            if (!groups.empty()) enforce_quotas(now, requeue);
+
+            // 2. Arrivals and finished I/O queue their next burst
+            while (next_arrival < order.size() && processes[order[next_arrival]].arrival_time == now) {
+                start_burst(order[next_arrival++], 0, now);
+            }
+            while (!io_done.empty() && io_done.top().first == now) {
+                int p = io_done.top().second;
+                io_done.pop();
+                Job& job = jobs[p];
+                chart[p].io_end_time = now;
+                emit(p, job.io_device, SegmentKind::Io, chart[p].io_start_time, now, nullptr);
+                free_io_devices.push(job.io_device);
+                job.io_device = -1;
+                start_burst(p, 2, now);
+            }
+
+            // 3. Preempted units go behind the newcomers
+            for (int u : requeue) enqueue(u);
+
+            dispatch(now);
+        }
+        stats.makespan = last;
+        for (int c = 0; c < (int)idle_since.size(); c++) {
+            SimTime wake;
+            stats.idle_energy += energy->idle_energy(last - idle_since[c], wake);
+        }
+        stats.remote_time += interleaved_time / topology.nodes() * (topology.nodes() - 1);
+    }
+};
+
+}  // namespace
+
+std::vector<ProcessGrantInfo> MultiCpuScheduler::cpu_process() {
+    MultiCpuOptions opts = options;
+    if (opts.topology.empty()) opts.topology = CpuTopology::uniform(std::max(opts.cpus, 1), 1);
+    opts.cpus = opts.topology.size();
+    opts.remote_slowdown = std::max(opts.remote_slowdown, 1);
+    if (opts.constraints != nullptr && opts.constraints->empty()) opts.constraints = nullptr;
+    if (opts.energy.pstates.empty() || opts.energy.cstates.empty()) opts.governor = FrequencyGovernor::None;
+    Run run(processes, opts);
+    run.simulate();
+    segment_table = std::move(run.segments);
+    run_stats = run.stats;
+    return std::move(run.chart);
+}
+
+namespace {
+
+SchedulerInfo multi_cpu_entry(std::string name, std::string title, std::vector<ParamSpec> params,
+                              CpuAllocation allocation) {
+    SchedulerInfo info;
+    info.name = std::move(name);
+    info.title = std::move(title);
+    info.params = std::move(params);
+    info.run = [allocation](const std::vector<Process>& p, const SchedulerParams& params, ScheduleSink& sink) {
+        MultiCpuOptions options;
+        options.cpus = params.get("cpus");
+        options.allocation = allocation;
+        options.quantum = SimTime(params.get("quantum"));
+        options.backfill = params.get("backfill", 1) != 0;
+        options.topology = CpuTopology::uniform(params.get("cpus"), params.get("sockets"), params.get("smt"),
+                                                params.get("llcs"));
+        options.placement = (MemoryPlacement)params.get("placement");
+        options.remote_slowdown = params.get("remote");
+        options.constraints = sink.cpu_constraints();
+        options.governor = (FrequencyGovernor)params.get("governor");
+        options.energy = EnergyModel::typical(SimTime(params.get("wake")));
+        MultiCpuScheduler scheduler(p, options);
+        sink.chart(scheduler.cpu_process());
+        sink.segments(scheduler.segments());
+        sink.multi_cpu(scheduler.stats());
+    };
+    return info;
+}
+
+// Machine shape, memory placement and power states, shared by both entries
+std::vector<ParamSpec> machine_params(std::vector<ParamSpec> params) {
+    std::vector<ParamSpec> machine = {
+        {"cpus", "number of CPUs (hardware threads)", 4, 1, 4096},
+        {"quantum", "time slice per turn; 0 runs a burst to the end", 0, 0, 1000000},
+        {"sockets", "sockets, one NUMA node each", 1, 1, 64},
+        {"smt", "hardware threads per core", 1, 1, 8},
+        {"llcs", "last-level caches per socket", 1, 1, 64},
+        {"placement", "memory placement: 0 first-touch, 1 interleave, 2 node-affine", 0, 0, 2},
+        {"remote", "run time on a remote node, percent of local", 100, 100, 1000},
+        {"governor", "DVFS governor: 0 none (no energy model), 1 performance, 2 powersave, 3 ondemand", 0, 0, 3},
+        {"wake", "exit latency of the deepest idle state (C6), ticks", 1, 0, 1000000}};
+    machine.insert(machine.end(), params.begin(), params.end());
+    return machine;
+}
+
+const SchedulerRegistration smp(multi_cpu_entry(
+    "smp", "Multi-CPU, threads scheduled independently", machine_params({}), CpuAllocation::Independent));
+
+const SchedulerRegistration gang(multi_cpu_entry(
+    "gang", "Multi-CPU, gang scheduling",
+    machine_params({{"backfill", "1 lets smaller gangs pass one that does not fit", 1, 0, 1}}), CpuAllocation::Gang));
+
+}  // namespace
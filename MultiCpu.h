@@ -0,0 +1,100 @@
+#ifndef MULTI_CPU_H
+#define MULTI_CPU_H
+
+#include <string>
+#include <vector>
+#include "CpuConstraints.h"
+#include "Energy.h"
+#include "MultiCpuStats.h"
+#include "Process.h"
+#include "ProcessGrantInfo.h"
+#include "Segment.h"
+#include "Topology.h"
+
+// Event-driven scheduler for a machine with several identical CPUs and
+// processes with several threads (Process::threads). Each of a process's
+// CPU bursts is run by all of its threads, and a burst ends at a barrier:
+// the process moves on to I/O (or finishes) only when its last thread is
+// done. I/O is per process and runs off the CPUs, as in Scheduler.h.
+//
+// How threads get CPUs:
+//   Independent  every thread is queued and dispatched on its own, to
+//                whichever CPU is free; threads that finish early wait at
+//                the barrier (barrier_wait_time)
+//   Gang         all threads of a process are dispatched together on
+//                distinct CPUs and preempted together. A process with more
+//                threads than CPUs runs as a gang of `cpus` members, each
+//                taking its share of the threads in turn; members with no
+//                thread left count as padding_time. CPUs left idle because
+//                the waiting gangs did not fit are fragmented_time.
+//
+// The ready queue is FIFO; with a quantum, a unit that uses up its slice
+// goes to the back. Without backfilling, a gang at the head that does not
+// fit blocks everyone behind it; with it, smaller gangs behind may start
+// first (which can postpone a wide gang for a long time).
+//
+// With a topology (Topology.h), each process's memory has a home node set
+// by the placement policy, and a thread on another node's CPU needs
+// remote_slowdown percent of the local time for the same work. A gang
+// moves at the pace of its slowest member. CPUs are chosen on an idle core before a busy core's
+// sibling, on the home node first under NodeAffine, and a gang stays on
+// one node when it fits; otherwise the lowest-numbered free CPU wins.
+//
+// Constraints (CpuConstraints.h) keep each thread on the CPUs of its
+// process's affinity mask (a gang is no wider than its mask), and throttle
+// a bandwidth group once it and its subgroups have used their quota for
+// the period: their threads leave the CPUs and stay queued until the next
+// period. Quota is enforced to within one tick per running thread.
+//
+// With a governor, each CPU has the P-states and C-states of `energy`
+// (Energy.h). A dispatch picks one P-state for the unit's CPUs, which
+// scales its speed, and first waits for the CPUs to leave their idle
+// states (wake_time); the run reports the energy drawn running and idle.
+// Racing to idle finishes bursts sooner and leaves CPUs idle long enough
+// to reach deep states, at the cost of wake-ups; running slowly spreads
+// the same work over more CPU time at lower power.
+
+enum class CpuAllocation {
+    Independent,
+    Gang
+};
+
+struct MultiCpuOptions {
+    int cpus = 4;
+    CpuAllocation allocation = CpuAllocation::Independent;
+    SimTime quantum{};     // 0: a dispatched unit runs its whole burst
+    bool backfill = true;  // Gang only
+    CpuTopology topology;  // Empty: `cpus` CPUs on one node
+    MemoryPlacement placement = MemoryPlacement::FirstTouch;
+    int remote_slowdown = 100;   // Run time on a remote node, percent of local
+    // Affinity and bandwidth limits; must outlive the run. A process whose
+    // mask holds no CPU of the machine never runs (see check_affinity).
+    const CpuConstraints* constraints = nullptr;
+    FrequencyGovernor governor = FrequencyGovernor::None;
+    EnergyModel energy;    // Used unless the governor is None
+};
+
+class MultiCpuScheduler {
+private:
+    std::vector<Process> processes;
+    MultiCpuOptions options;
+    SegmentTable segment_table;
+    MultiCpuStats run_stats;
+
+public:
+    std::string ClassName = "MultiCpuScheduler";
+
+    explicit MultiCpuScheduler(const std::vector<Process>& procs, MultiCpuOptions opts = MultiCpuOptions())
+        : processes(procs), options(opts) {}
+
+    // One record per process, in input order: burst starts are the first
+    // dispatch of any of its threads, burst ends the barrier
+    std::vector<ProcessGrantInfo> cpu_process();
+
+    // Per-CPU slices of the last run (Segment::resource is the CPU)
+    const SegmentTable& segments() const { return segment_table; }
+
+    const MultiCpuStats& stats() const { return run_stats; }
+};
+
+#endif
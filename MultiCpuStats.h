@@ -0,0 +1,60 @@
+#ifndef MULTI_CPU_STATS_H
+#define MULTI_CPU_STATS_H
+
+#include <cstdint>
+#include "SimTime.h"
+
+// Machine-level totals of a multi-CPU run (see MultiCpu.h), in CPU-ticks
+// unless noted. Capacity is cpus * makespan; every CPU-tick of it is
+// either busy or idle.
+struct MultiCpuStats {
+    int cpus = 0;
+    SimTime makespan{};               // Time of the last completion
+    SimTime busy_time{};              // CPUs held by running threads
+    SimTime padding_time{};           // Of busy_time: gang members with no thread left to run
+    SimTime idle_time{};              // CPUs with nothing running
+    SimTime fragmented_time{};        // Of idle_time: while ready work waited for more free CPUs
+    SimTime barrier_wait_time{};      // Thread-ticks spent finished, waiting for sibling threads
+    uint64_t dispatches = 0;
+
+    // With a topology (see MultiCpu.h)
+    int nodes = 1;
+    SimTime remote_time{};            // Of busy_time: on a node other than the memory's home
+                                      // (for interleaved memory, the remote share of every tick)
+    SimTime numa_stall_time{};        // Of busy_time: spent beyond local speed on remote accesses
+    uint64_t migrations = 0;          // Threads resumed on another CPU within a burst
+    uint64_t llc_migrations = 0;      // ... on a CPU behind another last-level cache
+    uint64_t node_migrations = 0;     // ... on another node
+
+    // With bandwidth groups
+    SimTime throttled_time{};         // Thread-ticks queued while their group was throttled
+    uint64_t throttles = 0;           // Times a group ran out of quota
+
+    // With an energy model (Energy.h)
+    bool energy_model = false;
+    double active_energy = 0;         // Watt-ticks drawn by busy CPUs, waking included
+    double idle_energy = 0;           // Watt-ticks drawn by idle CPUs in their C-states
+    SimTime wake_time{};              // Of busy_time: held while leaving idle states
+    uint64_t wakeups = 0;             // CPUs that had to leave an idle state for a dispatch
+    SimTime frequency_stall_time{};   // Of busy_time: spent beyond nominal speed at a lower P-state
+
+    double capacity() const { return (double)cpus * (double)makespan.ticks(); }
+
+    double energy() const { return active_energy + idle_energy; }
+
+    // Share of capacity that did useful work at full speed
+    double utilization() const {
+        SimTime lost = padding_time + numa_stall_time + wake_time + frequency_stall_time;
+        return capacity() > 0 ? (double)(busy_time - lost).ticks() / capacity() : 0;
+    }
+
+    // Share of busy time run away from home memory
+    double remote_share() const {
+        return busy_time > SimTime(0) ? (double)remote_time.ticks() / (double)busy_time.ticks() : 0;
+    }
+
+    // Share of capacity lost to idle CPUs that could not take waiting work
+    double fragmentation() const { return capacity() > 0 ? (double)fragmented_time.ticks() / capacity() : 0; }
+};
+
+#endif
@@ -65,7 +65,8 @@ vector<Process> getProcessData()
 
     for (int i = 1; i <= n; i++)
     {
-        int arrival_time, cpu_burst1, io_time, cpu_burst2, priority;
+        SimTime arrival_time, cpu_burst1, io_time, cpu_burst2;
+        int priority;
         cout << "\nProcess P" << i << ":\n";
         cout << "Arrival Time: ";
         cin >> arrival_time;
@@ -143,7 +144,7 @@ vector<Process> loadProcessDataFromFile()
     int id = 1, at, cpu1, io, cpu2, prio;
     while (file >> at >> cpu1 >> io >> cpu2 >> prio)
     {
-        processes.push_back(Process("P" + to_string(id++), at, cpu1, io, cpu2, prio));
+        processes.push_back(Process("P" + to_string(id++), SimTime(at), SimTime(cpu1), SimTime(io), SimTime(cpu2), prio));
     }
     cout << processes.size() << " processes loaded.\n";
     return processes;
@@ -159,10 +160,10 @@ vector<Process> generateRandomProcesses()
     for (int i = 1; i <= n; i++)
     {
         processes.push_back(Process("P" + to_string(i),
-                                    rand() % 20,
-                                    1 + rand() % 10,
-                                    rand() % 10,
-                                    rand() % 10,
+                                    SimTime(rand() % 20),
+                                    SimTime(1 + rand() % 10),
+                                    SimTime(rand() % 10),
+                                    SimTime(rand() % 10),
                                     1 + rand() % 10));
     }
     cout << n << " processes generated.\n";
@@ -0,0 +1,31 @@
+#ifndef PROCESS_COUNTERS_H
+#define PROCESS_COUNTERS_H
+
+#include <vector>
+
+// Scheduling events of one process over a run, reported by the Scheduler<>
+// engines alongside the chart (see ScheduleSink::counters)
+struct ProcessCounters {
+    int dispatches = 0;    // Times it was given the CPU
+    int preemptions = 0;   // Times it lost the CPU to an arrival with work left
+    int io_yields = 0;     // Times it gave up the CPU to do I/O
+    int demotions = 0;     // Times it moved down a feedback-queue level (MLFQ)
+};
+
+// The same events summed over every process of a run
+struct RunCounters {
+    long long dispatches = 0;
+    long long preemptions = 0;
+    long long io_yields = 0;
+    long long demotions = 0;
+    long long context_switches = 0;   // Dispatches of a different process than the one that ran last
+
+    void add(const ProcessCounters& c) {
+        dispatches += c.dispatches;
+        preemptions += c.preemptions;
+        io_yields += c.io_yields;
+        demotions += c.demotions;
+    }
+};
+
+#endif
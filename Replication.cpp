@@ -0,0 +1,168 @@
+#include "Replication.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <mutex>
+#include <thread>
+#include "Workload.h"
+
+void MetricSketch::add(double x) {
+    n++;
+    if (n == 1) {
+        lowest = highest = x;
+    } else {
+        lowest = std::min(lowest, x);
+        highest = std::max(highest, x);
+    }
+    double delta = x - mean_value;
+    mean_value += delta / (double)n;
+    m2 += delta * (x - mean_value);
+}
+
+void MetricSketch::merge(const MetricSketch& other) {
+    if (other.n == 0) return;
+    if (n == 0) {
+        *this = other;
+        return;
+    }
+    uint64_t total = n + other.n;
+    double delta = other.mean_value - mean_value;
+    mean_value += delta * (double)other.n / (double)total;
+    m2 += other.m2 + delta * delta * (double)n * (double)other.n / (double)total;
+    lowest = std::min(lowest, other.lowest);
+    highest = std::max(highest, other.highest);
+    n = total;
+}
+
+double MetricSketch::stddev() const {
+    return std::sqrt(variance());
+}
+
+double MetricSketch::ci95() const {
+    if (n < 2) return 0;
+    return student_t95(n - 1) * stddev() / std::sqrt((double)n);
+}
+
+double student_t95(uint64_t df) {
+    // Exact to three decimals up to 30 degrees of freedom
+    static const double table[] = {0,     12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                                   2.201, 2.179,  2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086, 2.080,
+                                   2.074, 2.069,  2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+    if (df == 0) return 0;
+    if (df <= 30) return table[df];
+    // Cornish-Fisher expansion around the normal quantile; under 1e-4 off
+    // past 30 degrees of freedom
+    const double z = 1.959963984540054;
+    double v = (double)df;
+    double z3 = z * z * z, z5 = z3 * z * z, z7 = z5 * z * z;
+    return z + (z3 + z) / (4 * v) + (5 * z5 + 16 * z3 + 3 * z) / (96 * v * v) +
+           (3 * z7 + 19 * z5 + 17 * z3 - 15 * z) / (384 * v * v * v);
+}
+
+const char* replicated_metric_name(ReplicatedMetric metric) {
+    switch (metric) {
+        case ReplicatedMetric::AvgResponse: return "avg_response_time";
+        case ReplicatedMetric::AvgTurnaround: return "avg_turnaround_time";
+        case ReplicatedMetric::AvgWaiting: return "avg_waiting_time";
+        case ReplicatedMetric::TotalTime: return "total_time";
+        case ReplicatedMetric::CpuEfficiency: return "cpu_efficiency";
+        case ReplicatedMetric::Throughput: return "throughput";
+        default: return "?";
+    }
+}
+
+unsigned replication_seed(unsigned base_seed, size_t k) {
+    // splitmix64 of (base, k)
+    uint64_t z = ((uint64_t)base_seed << 32) + (uint64_t)k + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return (unsigned)((z ^ (z >> 31)) & 0xFFFFFFFFu);
+}
+
+namespace {
+
+// Only the chart (and a multi-CPU run's totals) is kept; slices are not
+// needed for the metrics
+class ChartSink : public ScheduleSink {
+public:
+    std::vector<ProcessGrantInfo> records;
+    MultiCpuStats cpu_stats;
+    bool has_cpu_stats = false;
+    void chart(const std::vector<ProcessGrantInfo>& r) override { records = r; }
+    void multi_cpu(const MultiCpuStats& stats) override {
+        cpu_stats = stats;
+        has_cpu_stats = true;
+    }
+};
+
+void add_summary(std::array<MetricSketch, kReplicatedMetricCount>& metrics, const AnalysisSummary& s) {
+    metrics[(size_t)ReplicatedMetric::AvgResponse].add(s.avg_response_time);
+    metrics[(size_t)ReplicatedMetric::AvgTurnaround].add(s.avg_turnaround_time);
+    metrics[(size_t)ReplicatedMetric::AvgWaiting].add(s.avg_waiting_time);
+    metrics[(size_t)ReplicatedMetric::TotalTime].add((double)s.total_time.ticks());
+    metrics[(size_t)ReplicatedMetric::CpuEfficiency].add(s.cpu_efficiency);
+    metrics[(size_t)ReplicatedMetric::Throughput].add(s.throughput);
+}
+
+}  // namespace
+
+bool run_replications(const std::vector<ReplicationConfig>& configs, const ReplicationOptions& options,
+                      std::vector<ReplicationResult>& results, std::string& error) {
+    const SchedulerRegistry& registry = SchedulerRegistry::instance();
+    using Sketches = std::vector<std::array<MetricSketch, kReplicatedMetricCount>>;
+
+    // Workers share nothing but the next replication index; each keeps its
+    // own sketches until the end
+    std::atomic<size_t> next(0);
+    std::atomic<bool> failed(false);
+    std::mutex error_lock;
+    auto worker = [&](Sketches& sketches) {
+        sketches.assign(configs.size(), {});
+        for (size_t k = next++; k < options.replications && !failed; k = next++) {
+            unsigned seed = replication_seed(options.base_seed, k);
+            std::vector<Process> workload = generate_random_workload(options.processes, seed, options.arrival_span);
+            if (options.max_threads > 1) assign_random_threads(workload, options.max_threads, seed);
+            for (size_t c = 0; c < configs.size(); c++) {
+                ChartSink sink;
+                std::string run_error;
+                auto start = std::chrono::steady_clock::now();
+                if (!registry.run(configs[c].algorithm, workload, configs[c].params, sink, run_error)) {
+                    std::lock_guard<std::mutex> guard(error_lock);
+                    if (!failed.exchange(true)) error = run_error;
+                    return;
+                }
+                auto end = std::chrono::steady_clock::now();
+                AnalysisSummary summary = GranttAnalysis(sink.records, workload, options.time_unit).summary();
+                if (sink.has_cpu_stats) apply_machine_totals(summary, sink.cpu_stats);
+                add_summary(sketches[c], summary);
+                if (options.stream != nullptr) {
+                    ResultRecord record = result_record((uint32_t)c, summary);
+                    record.replication = (uint32_t)k;
+                    record.seed = seed;
+                    record.wall_ms = std::chrono::duration<double, std::milli>(end - start).count();
+                    options.stream->push(record);
+                }
+            }
+        }
+    };
+
+    size_t thread_count = std::max<size_t>(1, std::min<size_t>((size_t)std::max(options.threads, 1),
+                                                               options.replications));
+    std::vector<Sketches> partial(thread_count);
+    std::vector<std::thread> pool;
+    for (size_t t = 1; t < thread_count; t++) pool.emplace_back(worker, std::ref(partial[t]));
+    worker(partial[0]);
+    for (auto& t : pool) t.join();
+    if (failed) return false;
+
+    results.assign(configs.size(), ReplicationResult());
+    for (size_t c = 0; c < configs.size(); c++) {
+        results[c].config = configs[c];
+        for (const auto& sketches : partial) {
+            for (size_t m = 0; m < kReplicatedMetricCount; m++) results[c].metrics[m].merge(sketches[c][m]);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,100 @@
+#ifndef REPLICATION_H
+#define REPLICATION_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "GranttAnalysis.h"
+#include "ResultStream.h"
+#include "SchedulerRegistry.h"
+#include "SimTime.h"
+
+// Independent replications: K random workloads, each from its own seed,
+// run under every configuration, with the per-run metrics summarised as a
+// mean and a 95% confidence interval across the K runs.
+//
+// Replication k uses the same workload for every configuration (common
+// random numbers), so differences between configurations are not blurred
+// by workload noise. Its seed depends only on the base seed and k, so the
+// same workloads are run whatever the thread count; only the order in
+// which per-thread sketches are merged (the last bits of the sums) varies.
+
+// Running mean and variance (Welford), mergeable across threads (Chan et
+// al.), so each worker keeps its own and they are combined once at the end
+class MetricSketch {
+private:
+    uint64_t n = 0;
+    double mean_value = 0;
+    double m2 = 0;   // Sum of squared deviations from the mean
+    double lowest = 0;
+    double highest = 0;
+
+public:
+    void add(double x);
+    void merge(const MetricSketch& other);
+
+    uint64_t count() const { return n; }
+    double mean() const { return mean_value; }
+    double variance() const { return n > 1 ? m2 / (double)(n - 1) : 0; }   // Sample variance
+    double stddev() const;
+    double min() const { return lowest; }
+    double max() const { return highest; }
+
+    // Half-width of the 95% confidence interval for the mean (Student t);
+    // 0 for fewer than two observations
+    double ci95() const;
+};
+
+// Two-sided 95% quantile of Student's t with `df` degrees of freedom
+double student_t95(uint64_t df);
+
+// The AnalysisSummary fields that are summarised
+enum class ReplicatedMetric {
+    AvgResponse,
+    AvgTurnaround,
+    AvgWaiting,
+    TotalTime,
+    CpuEfficiency,
+    Throughput,
+    Count
+};
+
+constexpr size_t kReplicatedMetricCount = (size_t)ReplicatedMetric::Count;
+
+const char* replicated_metric_name(ReplicatedMetric metric);
+
+// One algorithm with its parameters
+struct ReplicationConfig {
+    std::string algorithm;
+    SchedulerParams params;
+};
+
+struct ReplicationOptions {
+    size_t replications = 30;
+    long long processes = 1000;   // Per workload
+    unsigned base_seed = 1;
+    int arrival_span = 20;        // See generate_random_workload()
+    int max_threads = 1;          // See assign_random_threads()
+    int threads = 1;
+    TimeUnit time_unit = TimeUnit::Milliseconds;
+    ResultWriter* stream = nullptr;   // Optional: every run's record as it finishes,
+                                      // with config = index into the configs
+};
+
+struct ReplicationResult {
+    ReplicationConfig config;
+    std::array<MetricSketch, kReplicatedMetricCount> metrics;
+};
+
+// Seed of replication k; spreads consecutive k over the whole seed space
+unsigned replication_seed(unsigned base_seed, size_t k);
+
+// Runs every configuration on options.replications workloads, spreading
+// the replications over options.threads threads. Returns false with a
+// message if a configuration fails to run.
+bool run_replications(const std::vector<ReplicationConfig>& configs, const ReplicationOptions& options,
+                      std::vector<ReplicationResult>& results, std::string& error);
+
+#endif
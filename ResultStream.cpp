@@ -0,0 +1,190 @@
+#include "ResultStream.h"
+
+#include <chrono>
+#include <cstring>
+#include <sstream>
+
+namespace {
+
+const char kResultMagic[8] = {'S', 'C', 'H', 'D', 'R', 'E', 'S', '1'};
+
+// Flush to the stream once this much text or data is buffered
+constexpr size_t kFlushBytes = 1 << 16;
+
+void put_u32(std::string& buffer, uint32_t v) {
+    for (int i = 0; i < 4; i++) buffer += (char)((v >> (8 * i)) & 0xFF);
+}
+
+void put_u64(std::string& buffer, uint64_t v) {
+    for (int i = 0; i < 8; i++) buffer += (char)((v >> (8 * i)) & 0xFF);
+}
+
+void put_f64(std::string& buffer, double v) {
+    uint64_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    put_u64(buffer, bits);
+}
+
+std::string json_escape(const std::string& text) {
+    std::string out;
+    for (char c : text) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+}  // namespace
+
+ResultRecord result_record(uint32_t config, const AnalysisSummary& summary) {
+    ResultRecord r;
+    r.config = config;
+    r.records = summary.records;
+    r.total_time = summary.total_time;
+    r.idle_time = summary.idle_time;
+    r.burst_time = summary.burst_time;
+    r.avg_response_time = summary.avg_response_time;
+    r.avg_turnaround_time = summary.avg_turnaround_time;
+    r.avg_waiting_time = summary.avg_waiting_time;
+    r.cpu_efficiency = summary.cpu_efficiency;
+    r.throughput = summary.throughput;
+    return r;
+}
+
+bool parse_result_format(const std::string& text, ResultFormat& format) {
+    if (text == "csv") {
+        format = ResultFormat::Csv;
+    } else if (text == "json") {
+        format = ResultFormat::Json;
+    } else if (text == "binary") {
+        format = ResultFormat::Binary;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+ResultWriter::ResultWriter(std::ostream& out, ResultFormat format, std::vector<std::string> config_names,
+                           size_t capacity)
+    : out(out), format(format), config_names(std::move(config_names)), queue(capacity) {
+    writer = std::thread(&ResultWriter::drain, this);
+}
+
+ResultWriter::~ResultWriter() {
+    finish();
+}
+
+void ResultWriter::push(const ResultRecord& record) {
+    if (queue.try_push(record)) return;
+    full_waits.fetch_add(1, std::memory_order_relaxed);
+    while (!queue.try_push(record)) std::this_thread::yield();
+}
+
+bool ResultWriter::finish() {
+    if (writer.joinable()) {
+        closing.store(true, std::memory_order_release);
+        writer.join();
+    }
+    return (bool)out;
+}
+
+void ResultWriter::write_header(std::string& buffer) const {
+    switch (format) {
+        case ResultFormat::Csv:
+            buffer += "algorithm,replication,seed,records,wall_ms,avg_response_time,avg_turnaround_time,"
+                      "avg_waiting_time,total_time,idle_time,burst_time,cpu_efficiency,throughput\n";
+            break;
+        case ResultFormat::Json:
+            buffer += "[";
+            break;
+        case ResultFormat::Binary:
+            buffer.append(kResultMagic, sizeof(kResultMagic));
+            put_u32(buffer, (uint32_t)config_names.size());
+            for (const auto& name : config_names) {
+                put_u32(buffer, (uint32_t)name.size());
+                buffer += name;
+            }
+            break;
+    }
+}
+
+void ResultWriter::write_record(std::string& buffer, const ResultRecord& r) {
+    const std::string unknown = "?";
+    const std::string& name = r.config < config_names.size() ? config_names[r.config] : unknown;
+    if (format == ResultFormat::Binary) {
+        put_u32(buffer, r.config);
+        put_u32(buffer, r.replication);
+        put_u32(buffer, r.seed);
+        put_u64(buffer, r.records);
+        put_u64(buffer, (uint64_t)r.total_time.ticks());
+        put_u64(buffer, (uint64_t)r.idle_time.ticks());
+        put_u64(buffer, (uint64_t)r.burst_time.ticks());
+        put_f64(buffer, r.avg_response_time);
+        put_f64(buffer, r.avg_turnaround_time);
+        put_f64(buffer, r.avg_waiting_time);
+        put_f64(buffer, r.cpu_efficiency);
+        put_f64(buffer, r.throughput);
+        put_f64(buffer, r.wall_ms);
+        return;
+    }
+
+    // Same number formatting as the metrics writers
+    std::ostringstream line;
+    if (format == ResultFormat::Csv) {
+        line << name << "," << r.replication << "," << r.seed << "," << r.records << "," << r.wall_ms << ","
+             << r.avg_response_time << "," << r.avg_turnaround_time << "," << r.avg_waiting_time << ","
+             << r.total_time << "," << r.idle_time << "," << r.burst_time << "," << r.cpu_efficiency << ","
+             << r.throughput << "\n";
+    } else {
+        line << (written == 0 ? "\n" : ",\n") << "  {\"algorithm\": \"" << json_escape(name) << "\""
+             << ", \"replication\": " << r.replication << ", \"seed\": " << r.seed
+             << ", \"records\": " << r.records << ", \"wall_ms\": " << r.wall_ms
+             << ", \"avg_response_time\": " << r.avg_response_time
+             << ", \"avg_turnaround_time\": " << r.avg_turnaround_time
+             << ", \"avg_waiting_time\": " << r.avg_waiting_time << ", \"total_time\": " << r.total_time
+             << ", \"idle_time\": " << r.idle_time << ", \"burst_time\": " << r.burst_time
+             << ", \"cpu_efficiency\": " << r.cpu_efficiency << ", \"throughput\": " << r.throughput << "}";
+    }
+    buffer += line.str();
+}
+
+// The writer thread. Spins briefly when the queue is empty, then backs off
+// to short sleeps so an idle writer does not hold a core.
+void ResultWriter::drain() {
+    std::string buffer;
+    write_header(buffer);
+    auto flush = [&]() {
+        out.write(buffer.data(), (std::streamsize)buffer.size());
+        buffer.clear();
+    };
+
+    ResultRecord record;
+    int idle = 0;
+    for (;;) {
+        // Read the flag before polling: once it is set every push has
+        // already been published, so an empty queue then means done
+        bool last = closing.load(std::memory_order_acquire);
+        bool any = false;
+        while (queue.try_pop(record)) {
+            write_record(buffer, record);
+            written++;
+            any = true;
+            if (buffer.size() >= kFlushBytes) flush();
+        }
+        if (any) {
+            idle = 0;
+            continue;
+        }
+        if (last) break;
+        if (!buffer.empty()) flush();
+        if (++idle < 64) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+
+    if (format == ResultFormat::Json) buffer += written == 0 ? "]\n" : "\n]\n";
+    flush();
+    out.flush();
+}
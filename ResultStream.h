@@ -0,0 +1,154 @@
+#ifndef RESULT_STREAM_H
+#define RESULT_STREAM_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "GranttAnalysis.h"
+#include "SimTime.h"
+
+// Per-run results streamed out of parallel runs. Workers push fixed-size
+// records into a lock-free queue; one writer thread drains it and is the
+// only thread that touches the output stream, so workers never wait on
+// each other or on iostream.
+//
+// Output formats:
+//  - csv: a header line, then one line per record
+//  - json: an array of objects, one per record
+//  - binary: the 8-byte magic "SCHDRES1", a little-endian uint32 count of
+//    configuration names, each name as a uint32 length and its bytes, then
+//    92-byte records: config, replication and seed (uint32), records
+//    (uint64), total, idle and burst time (int64), then average response,
+//    turnaround and waiting time, CPU efficiency, throughput and wall time
+//    in ms (IEEE doubles), all little-endian
+// Records appear in the order runs finish, not in configuration order.
+
+// One finished run; plain data so that queueing it never allocates
+struct ResultRecord {
+    uint32_t config = 0;        // Index into the writer's configuration names
+    uint32_t replication = 0;
+    uint32_t seed = 0;
+    uint64_t records = 0;
+    SimTime total_time{};
+    SimTime idle_time{};
+    SimTime burst_time{};
+    double avg_response_time = 0;
+    double avg_turnaround_time = 0;
+    double avg_waiting_time = 0;
+    double cpu_efficiency = 0;
+    double throughput = 0;
+    double wall_ms = 0;
+};
+
+ResultRecord result_record(uint32_t config, const AnalysisSummary& summary);
+
+// Bounded multi-producer, single-consumer ring (Vyukov's sequence-numbered
+// slots). Producers claim a slot with one CAS on the tail and publish it by
+// bumping the slot's sequence; the consumer owns the head outright.
+template <class T>
+class MpscQueue {
+private:
+    struct alignas(64) Slot {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    size_t mask;
+    alignas(64) std::atomic<size_t> tail{0};   // Next position producers claim
+    alignas(64) size_t head = 0;               // Next position the consumer reads
+
+public:
+    // Capacity is rounded up to a power of two
+    explicit MpscQueue(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) size <<= 1;
+        slots.reset(new Slot[size]);
+        mask = size - 1;
+        for (size_t i = 0; i < size; i++) slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    size_t capacity() const { return mask + 1; }
+
+    // False when the queue is full
+    bool try_push(const T& value) {
+        size_t pos = tail.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots[pos & mask];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+            if (diff == 0) {
+                if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.value = value;
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Consumer only; false when nothing is published yet
+    bool try_pop(T& value) {
+        Slot& slot = slots[head & mask];
+        if (slot.sequence.load(std::memory_order_acquire) != head + 1) return false;
+        value = slot.value;
+        slot.sequence.store(head + mask + 1, std::memory_order_release);
+        head++;
+        return true;
+    }
+};
+
+enum class ResultFormat { Csv, Json, Binary };
+
+// "csv", "json" or "binary"
+bool parse_result_format(const std::string& text, ResultFormat& format);
+
+// Owns the queue and the writer thread. The stream must outlive finish().
+class ResultWriter {
+private:
+    std::ostream& out;
+    ResultFormat format;
+    std::vector<std::string> config_names;
+    MpscQueue<ResultRecord> queue;
+    std::atomic<bool> closing{false};
+    std::atomic<uint64_t> full_waits{0};
+    uint64_t written = 0;   // Writer thread only until finish()
+    std::thread writer;
+
+    void drain();
+    void write_header(std::string& buffer) const;
+    void write_record(std::string& buffer, const ResultRecord& r);
+
+public:
+    ResultWriter(std::ostream& out, ResultFormat format, std::vector<std::string> config_names,
+                 size_t capacity = 4096);
+    ~ResultWriter();
+
+    ResultWriter(const ResultWriter&) = delete;
+    ResultWriter& operator=(const ResultWriter&) = delete;
+
+    // Any thread. Spins (yielding) while the queue is full, so a slow
+    // stream throttles the workers instead of growing without bound.
+    void push(const ResultRecord& record);
+
+    // After every producer is done: drains the rest, writes any trailer and
+    // stops the thread. Returns false if the stream failed.
+    bool finish();
+
+    uint64_t records_written() const { return written; }       // Valid after finish()
+    uint64_t producer_waits() const { return full_waits.load(std::memory_order_relaxed); }
+};
+
+#endif
@@ -0,0 +1,74 @@
+#include "RunArena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+RunArena::RunArena(size_t first_block_size) : first_block_size(std::max<size_t>(first_block_size, 64)) {}
+
+RunArena::~RunArena() {
+    for (auto& b : blocks) ::operator delete(b.data);
+}
+
+RunArena::Block RunArena::new_block(size_t size) {
+    return {static_cast<char*>(::operator new(size)), size};
+}
+
+void* RunArena::do_allocate(size_t bytes, size_t alignment) {
+    // Try the current block, then any spare blocks left from earlier runs
+    for (size_t b = current; b < blocks.size(); b++) {
+        size_t start = b == current ? offset : 0;
+        uintptr_t base = reinterpret_cast<uintptr_t>(blocks[b].data);
+        size_t aligned = ((base + start + alignment - 1) & ~(uintptr_t)(alignment - 1)) - base;
+        if (aligned + bytes <= blocks[b].size) {
+            current = b;
+            offset = aligned + bytes;
+            return blocks[b].data + aligned;
+        }
+    }
+
+    // Grow geometrically so a run needs O(log n) blocks
+    size_t size = blocks.empty() ? first_block_size : blocks.back().size * 2;
+    size = std::max(size, bytes + alignment);
+    blocks.push_back(new_block(size));
+    current = blocks.size() - 1;
+
+    uintptr_t base = reinterpret_cast<uintptr_t>(blocks[current].data);
+    size_t aligned = ((base + alignment - 1) & ~(uintptr_t)(alignment - 1)) - base;
+    offset = aligned + bytes;
+    return blocks[current].data + aligned;
+}
+
+void RunArena::rewind(Mark m) {
+    if (m.block > current || (m.block == current && m.offset > offset)) return;
+    current = m.block;
+    offset = m.offset;
+}
+
+void RunArena::reset() {
+    if (blocks.size() > 1) {
+        size_t total = capacity();
+        for (auto& b : blocks) ::operator delete(b.data);
+        blocks.clear();
+        blocks.push_back(new_block(total));
+    }
+    current = 0;
+    offset = 0;
+}
+
+size_t RunArena::used() const {
+    size_t total = offset;
+    for (size_t b = 0; b < current && b < blocks.size(); b++) total += blocks[b].size;
+    return total;
+}
+
+size_t RunArena::capacity() const {
+    size_t total = 0;
+    for (const auto& b : blocks) total += b.size;
+    return total;
+}
+
+RunArena& RunArena::local() {
+    thread_local RunArena arena;
+    return arena;
+}
@@ -0,0 +1,89 @@
+#ifndef RUN_ARENA_H
+#define RUN_ARENA_H
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+// Monotonic allocator for the scratch state of one scheduling run (ready
+// queues, copies of the workload, event heaps). Allocation bumps a pointer,
+// deallocation is a no-op, and everything is released at once when the
+// run's ArenaScope ends.
+//
+// Blocks are kept between runs: when the outermost scope closes, an arena
+// that had to grow is consolidated into one block of the combined size, so
+// repeated runs of a similar size stop touching malloc after the first.
+//
+// Use it through std::pmr containers:
+//
+//   ArenaScope scope;
+//   std::pmr::vector<Process> ready(scope.resource());
+class RunArena : public std::pmr::memory_resource {
+public:
+    // Position to rewind to; see ArenaScope
+    struct Mark {
+        size_t block = 0;
+        size_t offset = 0;
+    };
+
+private:
+    struct Block {
+        char* data;
+        size_t size;
+    };
+
+    std::vector<Block> blocks;
+    size_t current = 0;   // Block being carved up
+    size_t offset = 0;    // Next free byte in blocks[current]
+    size_t first_block_size;
+
+    Block new_block(size_t size);
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void*, size_t, size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+public:
+    explicit RunArena(size_t first_block_size = 256 * 1024);
+    ~RunArena() override;
+
+    RunArena(const RunArena&) = delete;
+    RunArena& operator=(const RunArena&) = delete;
+
+    Mark mark() const { return {current, offset}; }
+
+    // Drops everything allocated since m. Memory is kept for reuse.
+    void rewind(Mark m);
+
+    // Drops everything and merges the blocks into one
+    void reset();
+
+    size_t used() const;        // Bytes handed out since the last reset
+    size_t capacity() const;    // Bytes held from the system
+
+    // One arena per thread, shared by every scheduler run on that thread
+    static RunArena& local();
+};
+
+// Marks the arena on entry and rewinds on exit, so scopes nest. The
+// outermost scope also consolidates the arena for the next run.
+class ArenaScope {
+private:
+    RunArena& arena;
+    RunArena::Mark start;
+
+public:
+    explicit ArenaScope(RunArena& a = RunArena::local()) : arena(a), start(a.mark()) {}
+    ~ArenaScope() {
+        if (start.block == 0 && start.offset == 0) arena.reset();
+        else arena.rewind(start);
+    }
+
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+    std::pmr::memory_resource* resource() const { return &arena; }
+};
+
+#endif
@@ -0,0 +1,113 @@
+#include "Scheduler.h"
+#include "SchedulerRegistry.h"
+
+#include <algorithm>
+#include <climits>
+
+// Registry entries for the policy combinations in Scheduler.h. These also
+// report their individual CPU/I/O slices to the sink, and can pause and
+// resume so that one prefix forks into several continuations.
+
+namespace {
+
+using Workload = std::shared_ptr<const std::vector<Process>>;
+
+// make(workload, params) builds the engine; the entry wires it to every
+// registry call
+template <class Make>
+SchedulerInfo engine_entry(std::string name, std::string title, std::vector<ParamSpec> params, Make make) {
+    SchedulerInfo info;
+    info.name = std::move(name);
+    info.title = std::move(title);
+    info.params = std::move(params);
+    info.run = [make](const std::vector<Process>& p, const SchedulerParams& params, ScheduleSink& sink) {
+        auto engine = make(std::make_shared<const std::vector<Process>>(p), params);
+        engine.set_counting(sink.wants_counters());
+        engine.set_decision_sampling(sink.decision_sample_every());
+        sink.chart(engine.cpu_process());
+        sink.segments(engine.segments());
+        if (sink.wants_counters()) sink.counters(engine.counters(), engine.run_counters());
+        if (sink.decision_sample_every() > 0) sink.decision_latency(engine.decision_latency());
+    };
+    info.resume_until = [make](const SimulationSnapshot& from, const SchedulerParams& params, SimTime time) {
+        return make(from.workload, params).resume_until(from, time);
+    };
+    info.resume = [make](const SimulationSnapshot& from, const SchedulerParams& params, ScheduleSink& sink) {
+        auto engine = make(from.workload, params);
+        engine.set_counting(sink.wants_counters());
+        engine.set_decision_sampling(sink.decision_sample_every());
+        sink.chart(engine.resume(from));
+        sink.segments(engine.segments());
+        if (sink.wants_counters()) sink.counters(engine.counters(), engine.run_counters());
+        if (sink.decision_sample_every() > 0) sink.decision_latency(engine.decision_latency());
+    };
+    return info;
+}
+
+const SchedulerRegistration fcfs(engine_entry(
+    "policy-fcfs", "First Come First Served (policy engine)", {},
+    [](Workload w, const SchedulerParams&) { return FcfsScheduler(std::move(w)); }));
+
+const SchedulerRegistration sjf(engine_entry(
+    "policy-sjf", "Shortest Job First (policy engine)", {},
+    [](Workload w, const SchedulerParams&) { return SjfScheduler(std::move(w)); }));
+
+const SchedulerRegistration rr(engine_entry(
+    "policy-rr", "Round Robin (policy engine)",
+    {{"quantum", "time slice per turn", 4, 1, 1000000}},
+    [](Workload w, const SchedulerParams& params) {
+        return RoundRobinScheduler(std::move(w), FixedQuantum(params.get("quantum")));
+    }));
+
+const SchedulerRegistration mlfq(engine_entry(
+    "policy-mlfq", "Multi-Level Feedback Queue (policy engine)",
+    {{"quantum", "quantum of the top level; doubles per level", 8, 1, 1000000},
+     {"levels", "round-robin levels above the FCFS bottom queue", 2, 1, 16}},
+    [](Workload w, const SchedulerParams& params) {
+        std::vector<int> quanta;
+        long long q = params.get("quantum");
+        for (int l = 0; l < params.get("levels"); l++, q *= 2) quanta.push_back((int)std::min<long long>(q, INT_MAX));
+        return MlfqScheduler(std::move(w), LevelQuantum(quanta));
+    }));
+
+const SchedulerRegistration priority(engine_entry(
+    "policy-priority", "Priority, non-preemptive (policy engine)", {},
+    [](Workload w, const SchedulerParams&) { return NonPreemptivePriorityScheduler(std::move(w)); }));
+
+const SchedulerRegistration priority_preemptive(engine_entry(
+    "policy-priority-preemptive", "Priority, preemptive (policy engine)", {},
+    [](Workload w, const SchedulerParams&) { return PreemptivePriorityScheduler(std::move(w)); }));
+
+const SchedulerRegistration fcfs_preemptive(engine_entry(
+    "policy-fcfs-preemptive", "FCFS Preemptive (policy engine)", {},
+    [](Workload w, const SchedulerParams&) { return FcfsPreemptiveScheduler(std::move(w)); }));
+
+// Preempts only when an arrival (or a return from I/O) has a shorter
+// remaining burst than the running task
+const SchedulerRegistration srtf(engine_entry(
+    "srtf", "Shortest Remaining Time First (policy engine)", {},
+    [](Workload w, const SchedulerParams&) { return SrtfScheduler(std::move(w)); }));
+
+const SchedulerRegistration hrrn(engine_entry(
+    "hrrn", "Highest Response Ratio Next (policy engine)", {},
+    [](Workload w, const SchedulerParams&) { return HrrnScheduler(std::move(w)); }));
+
+// Proportional share; Process::priority is the ticket count
+const SchedulerRegistration lottery(engine_entry(
+    "lottery", "Lottery (proportional share)",
+    {{"quantum", "time slice per draw", 4, 1, 1000000},
+     {"seed", "random seed for the draws", 1, 0, INT_MAX}},
+    [](Workload w, const SchedulerParams& params) {
+        QueueOptions options;
+        options.seed = (uint64_t)params.get("seed");
+        return LotteryScheduler(std::move(w), FixedQuantum(params.get("quantum")), options);
+    }));
+
+const SchedulerRegistration stride(engine_entry(
+    "stride", "Stride (proportional share)",
+    {{"quantum", "time slice per turn", 4, 1, 1000000}},
+    [](Workload w, const SchedulerParams& params) {
+        return StrideScheduler(std::move(w), FixedQuantum(params.get("quantum")));
+    }));
+
+}  // namespace
@@ -0,0 +1,465 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <queue>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+#include "DecisionLatency.h"
+#include "Instrumentation.h"
+#include "Process.h"
+#include "ProcessGrantInfo.h"
+#include "ProcessCounters.h"
+#include "Segment.h"
+#include "RunArena.h"
+#include "SchedulerPolicies.h"
+#include "SimulationSnapshot.h"
+
+// Event-driven single-CPU scheduler assembled from compile-time policies:
+//
+//   QueuePolicy       which ready task runs next (FifoQueue, PriorityQueue, ...)
+//   PreemptionPolicy  whether arrivals may displace the running task
+//   QuantumPolicy     how long a dispatched task may run
+//
+// Time jumps from event to event (arrival, I/O completion, end of slice),
+// so cost grows with the number of events rather than with the length of
+// the schedule. I/O runs off the CPU, in parallel with other work.
+// Ready queues and event heaps come from the thread's RunArena.
+//
+// A run can be paused with run_until() and continued with resume(), by
+// this scheduler or by one with different policies (see SimulationSnapshot).
+//
+// Scheduling events (dispatches, preemptions, I/O yields, demotions) are
+// counted unless set_counting(false) turns that off; see counters().
+// set_decision_sampling() times the ready-queue inserts and picks
+// themselves; see decision_latency().
+//
+// A new algorithm is a policy type plus an alias at the bottom of this file.
+template <class QueuePolicy, class PreemptionPolicy, class QuantumPolicy>
+class Scheduler {
+private:
+    // Scratch state of one call, allocated from the run arena and
+    // destroyed before the arena is rewound
+    struct RunState {
+        QueuePolicy queue;
+        std::priority_queue<std::pair<SimTime, int>, std::pmr::vector<std::pair<SimTime, int>>,
+                            std::greater<std::pair<SimTime, int>>> io_done;   // (time, task)
+        std::priority_queue<int, std::pmr::vector<int>, std::greater<int>> free_io_devices;
+
+        RunState(std::pmr::memory_resource* arena, const QueueOptions& options)
+            : queue(make_queue(arena, options)),
+              io_done(std::greater<std::pair<SimTime, int>>(), std::pmr::vector<std::pair<SimTime, int>>(arena)),
+              free_io_devices(std::greater<int>(), std::pmr::vector<int>(arena)) {}
+    };
+
+    static QueuePolicy make_queue(std::pmr::memory_resource* arena, const QueueOptions& options) {
+        if constexpr (std::is_constructible_v<QueuePolicy, std::pmr::memory_resource*, const QueueOptions&>) {
+            return QueuePolicy(arena, options);
+        } else {
+            return QueuePolicy(arena);
+        }
+    }
+
+    // Queues that carry state of their own across a pause (LotteryQueue, ...)
+    template <class Q, class = void>
+    struct has_queue_state : std::false_type {};
+    template <class Q>
+    struct has_queue_state<Q, std::void_t<decltype(std::declval<const Q&>().save_state())>> : std::true_type {};
+
+    // Queues whose choice depends on the time (ResponseRatioQueue)
+    template <class Q, class = void>
+    struct has_timed_pop : std::false_type {};
+    template <class Q>
+    struct has_timed_pop<Q, std::void_t<decltype(std::declval<Q&>().pop_at(SimTime()))>> : std::true_type {};
+
+    static constexpr SimTime never = kSimTimeMax;
+
+    std::shared_ptr<const std::vector<Process>> workload;
+    QuantumPolicy quantum;
+    QueueOptions queue_options;
+    SegmentTable segment_table;
+    std::vector<ProcessCounters> counter_table;
+    RunCounters run_totals;
+    bool counting = true;
+    uint32_t decision_sample_every = 0;
+    DecisionSampler enqueue_sampler, pick_sampler;
+    DecisionLatency latency_totals;
+
+    SimulationSnapshot sim;          // Everything that survives a pause
+    std::optional<RunState> state;
+
+    void emit(int task, int resource, SegmentKind kind, SimTime start, SimTime end) {
+        if (end <= start) return;
+        SCHED_TIME_SCOPE(Stage::ChartEmit);
+        sim.segment_end_time = std::max(sim.segment_end_time, end);
+        // Back-to-back slices of the same task collapse into one segment
+        if (!sim.segments.empty()) {
+            const Segment& last = sim.segments.back();
+            if (last.row == task && last.kind == kind && last.resource == resource && last.end == start) {
+                sim.segments.back_mut().end = end;
+                SCHED_COUNT(InstrumentCounter::SegmentsMerged);
+                return;
+            }
+        }
+        sim.segments.push_back(Segment(task, resource, kind, start, end));
+    }
+
+    // Moves a task whose current phase just finished into the next one
+    void advance(int t, SimTime now) {
+        Task& task = sim.tasks.mut(t);
+        ProcessGrantInfo& info = sim.chart.mut(t);
+        const Process& p = sim.process(t);
+
+        if (task.phase == 0) {
+            info.cpu_end_time1 = now;
+            task.phase = 1;
+            info.io_start_time = now;
+            if (p.io_time > SimTime(0)) {
+                if (counting) task.counters.io_yields++;
+                if (state->free_io_devices.empty()) state->free_io_devices.push(sim.io_devices_used++);
+                task.io_device = state->free_io_devices.top();
+                state->free_io_devices.pop();
+                state->io_done.push({now + p.io_time, t});
+                return;
+            }
+            info.io_end_time = now;
+        }
+        if (task.phase == 1) {
+            task.phase = 2;
+            task.remaining = p.cpu_burst_time2;
+            if (task.remaining > SimTime(0)) {
+                info.cpu_start_time2 = SimTime(-1);   // fixed at first dispatch
+                make_ready(t, now);
+                return;
+            }
+            info.cpu_start_time2 = now;
+        }
+        task.phase = 3;
+        info.cpu_end_time2 = now;
+        sim.completed++;
+    }
+
+    void make_ready(int t, SimTime now) {
+        Task& task = sim.tasks.mut(t);
+        task.ready_since = now;
+        SCHED_TIME_SCOPE(Stage::QueuePush);
+        if (enqueue_sampler.due()) {
+            uint64_t start = decision_clock();
+            state->queue.push(task);
+            latency_totals.enqueue.add(decision_clock() - start);
+        } else {
+            state->queue.push(task);
+        }
+    }
+
+    // Charges the running task for the time it has used so far
+    void charge_running(SimTime now) {
+        Task& task = sim.tasks.mut(sim.running);
+        task.remaining -= now - sim.slice_start;
+        state->queue.charge(task, now - sim.slice_start);
+        emit(sim.running, 0, SegmentKind::Cpu, sim.slice_start, now);
+        sim.slice_start = now;
+    }
+
+    void dispatch(SimTime now) {
+        SCHED_TIME_SCOPE(Stage::Dispatch);
+        {
+            SCHED_TIME_SCOPE(Stage::QueuePop);
+            bool timed = pick_sampler.due();
+            size_t ready = timed ? state->queue.size() : 0;
+            uint64_t start = timed ? decision_clock() : 0;
+            if constexpr (has_timed_pop<QueuePolicy>::value) {
+                sim.running = state->queue.pop_at(now);
+            } else {
+                sim.running = state->queue.pop();
+            }
+            if (timed) latency_totals.add_pick(decision_clock() - start, ready);
+        }
+        if (counting) {
+            sim.tasks.mut(sim.running).counters.dispatches++;
+            if (sim.running != sim.last_on_cpu && sim.last_on_cpu >= 0) sim.context_switches++;
+            sim.last_on_cpu = sim.running;
+        }
+
+        const Task& task = sim.tasks[sim.running];
+        const ProcessGrantInfo& info = sim.chart[sim.running];
+
+        // First dispatch of a burst fixes its start time
+        if (task.phase == 0 && info.cpu_start_time1 < SimTime(0)) sim.chart.mut(sim.running).cpu_start_time1 = now;
+        if (task.phase == 2 && info.cpu_start_time2 < SimTime(0)) sim.chart.mut(sim.running).cpu_start_time2 = now;
+
+        sim.slice_start = now;
+        sim.slice_end = now + quantum.slice(task);
+    }
+
+    void start_sampling() {
+        enqueue_sampler = DecisionSampler(decision_sample_every);
+        pick_sampler = DecisionSampler(decision_sample_every);
+        latency_totals = DecisionLatency();
+        latency_totals.sample_every = decision_sample_every;
+    }
+
+    void start_fresh() {
+        start_sampling();
+        sim = initial_snapshot(workload);
+    }
+
+    // Takes over a snapshot and refills the scratch queues from its lists
+    void restore(const SimulationSnapshot& from) {
+        start_sampling();
+        sim = from;
+        workload = from.workload;
+        if constexpr (has_queue_state<QueuePolicy>::value) {
+            if (sim.queue_policy == typeid(QueuePolicy).hash_code()) state->queue.load_state(sim.queue_state);
+        }
+        for (int t : sim.ready) state->queue.push(sim.tasks[t]);
+        for (const auto& io : sim.io_pending) state->io_done.push(io);
+        for (int d : sim.free_io_devices) state->free_io_devices.push(d);
+        sim.ready.clear();
+        sim.io_pending.clear();
+        sim.free_io_devices.clear();
+    }
+
+    // Drains the scratch queues into the snapshot's lists and hands it over
+    SimulationSnapshot capture(SimTime time) {
+        sim.time = time;
+        if constexpr (has_queue_state<QueuePolicy>::value) {
+            sim.queue_policy = typeid(QueuePolicy).hash_code();
+            sim.queue_state = state->queue.save_state();   // Before draining, which may change it
+        }
+        while (!state->queue.empty()) sim.ready.push_back(state->queue.pop());
+        while (!state->io_done.empty()) {
+            sim.io_pending.push_back(state->io_done.top());
+            state->io_done.pop();
+        }
+        while (!state->free_io_devices.empty()) {
+            sim.free_io_devices.push_back(state->free_io_devices.top());
+            state->free_io_devices.pop();
+        }
+        SimulationSnapshot snapshot = std::move(sim);
+        sim = SimulationSnapshot();
+        return snapshot;
+    }
+
+    // Handles every event before `until`
+    void run_events(SimTime until) {
+        const int n = (int)workload->size();
+
+        while (sim.completed < n) {
+            SimTime now = never;
+            SimTime arrival;
+            if (sim.next_arrival_time(arrival)) now = arrival;
+            if (!state->io_done.empty()) now = std::min(now, state->io_done.top().first);
+            if (sim.running >= 0) now = std::min(now, sim.slice_end);
+            if (now >= until) break;
+            SCHED_COUNT(InstrumentCounter::Events);
+
+            // 1. The running slice ends: burst done or quantum used up
+            int requeue = -1;
+            if (sim.running >= 0 && sim.slice_end == now) {
+                charge_running(now);
+                if (sim.tasks[sim.running].remaining == SimTime(0)) {
+                    advance(sim.running, now);
+                } else {
+                    SCHED_COUNT(InstrumentCounter::QuantumExpiries);
+                    Task& task = sim.tasks.mut(sim.running);
+                    int level = task.level;
+                    quantum.on_expire(task);
+                    if (counting && task.level > level) task.counters.demotions++;
+                    requeue = sim.running;
+                }
+                sim.running = -1;
+            }
+
+            // 2. Arrivals and finished I/O join the ready queue
+            bool arrived = false;
+            while (sim.next_arrival_time(arrival) && arrival == now) {
+                SCHED_TIME_SCOPE(Stage::Arrival);
+                int t = sim.admit_next();
+                if (sim.tasks[t].remaining > SimTime(0)) {
+                    make_ready(t, now);
+                    arrived = true;
+                } else {
+                    sim.chart.mut(t).cpu_start_time1 = now;
+                    advance(t, now);
+                    arrived = arrived || sim.tasks[t].phase == 2;
+                }
+            }
+            while (!state->io_done.empty() && state->io_done.top().first == now) {
+                SCHED_COUNT(InstrumentCounter::IoCompletions);
+                int t = state->io_done.top().second;
+                state->io_done.pop();
+                Task& task = sim.tasks.mut(t);
+                int device = task.io_device;
+                task.io_device = -1;
+                ProcessGrantInfo& info = sim.chart.mut(t);
+                info.io_end_time = now;
+                emit(t, device, SegmentKind::Io, info.io_start_time, now);
+                state->free_io_devices.push(device);
+                advance(t, now);
+                arrived = arrived || sim.tasks[t].phase == 2;
+            }
+
+            // 3. A task whose quantum expired goes behind the newcomers
+            if (requeue >= 0) make_ready(requeue, now);
+
+            // 4. Newcomers may displace the running task
+            if constexpr (PreemptionPolicy::on_arrival) {
+                if (arrived && sim.running >= 0) {
+                    charge_running(now);
+                    if (state->queue.preempts(sim.tasks[sim.running])) {
+                        if (counting) sim.tasks.mut(sim.running).counters.preemptions++;
+                        make_ready(sim.running, now);
+                        sim.running = -1;
+                    }
+                }
+            }
+
+            if (sim.running < 0 && !state->queue.empty()) dispatch(now);
+        }
+    }
+
+    std::vector<ProcessGrantInfo> finish() {
+        SCHED_TIME_SCOPE(Stage::ChartEmit);
+        segment_table = SegmentTable();
+        segment_table.rows.reserve(workload->size());
+        for (const auto& p : *workload) segment_table.rows.push_back(p.pid);
+        // Tasks are numbered by arrival; results go back to input order
+        const std::vector<int>& order = *sim.arrival_order;
+        segment_table.segments = sim.segments.to_vector();
+        for (auto& s : segment_table.segments) s.row = order[s.row];
+        segment_table.end_time = sim.segment_end_time;
+
+        std::vector<int> rank(order.size());
+        for (size_t r = 0; r < order.size(); r++) rank[order[r]] = (int)r;
+        std::vector<ProcessGrantInfo> chart;
+        chart.reserve(order.size());
+        for (size_t i = 0; i < rank.size(); i++) chart.push_back(sim.chart[rank[i]]);
+
+        counter_table.clear();
+        run_totals = RunCounters();
+        if (counting) {
+            counter_table.reserve(order.size());
+            for (size_t i = 0; i < rank.size(); i++) {
+                counter_table.push_back(sim.tasks[rank[i]].counters);
+                run_totals.add(counter_table.back());
+            }
+            run_totals.context_switches = sim.context_switches;
+        }
+        sim = SimulationSnapshot();
+        return chart;
+    }
+
+public:
+    std::string ClassName = "Scheduler";
+
+    explicit Scheduler(const std::vector<Process>& procs, QuantumPolicy quantum_policy = QuantumPolicy(),
+                       QueueOptions options = QueueOptions())
+        : workload(std::make_shared<const std::vector<Process>>(procs)),
+          quantum(std::move(quantum_policy)),
+          queue_options(options) {}
+
+    // Shares the workload instead of copying it, e.g. a snapshot's
+    explicit Scheduler(std::shared_ptr<const std::vector<Process>> procs,
+                       QuantumPolicy quantum_policy = QuantumPolicy(), QueueOptions options = QueueOptions())
+        : workload(std::move(procs)), quantum(std::move(quantum_policy)), queue_options(options) {}
+
+    std::vector<ProcessGrantInfo> cpu_process() {
+        ArenaScope scope;
+        state.emplace(scope.resource(), queue_options);
+        start_fresh();
+        run_events(never);
+        state.reset();   // Before the scope hands the arena to the next run
+        return finish();
+    }
+
+    // Runs from time 0 and pauses before the first event at or after `time`
+    SimulationSnapshot run_until(SimTime time) {
+        ArenaScope scope;
+        state.emplace(scope.resource(), queue_options);
+        start_fresh();
+        run_events(time);
+        SimulationSnapshot snapshot = capture(time);
+        state.reset();
+        return snapshot;
+    }
+
+    // Continues a snapshot, possibly taken under other policies, to the end
+    std::vector<ProcessGrantInfo> resume(const SimulationSnapshot& from) {
+        ArenaScope scope;
+        state.emplace(scope.resource(), queue_options);
+        restore(from);
+        run_events(never);
+        state.reset();
+        return finish();
+    }
+
+    // Continues a snapshot and pauses again at a later time
+    SimulationSnapshot resume_until(const SimulationSnapshot& from, SimTime time) {
+        ArenaScope scope;
+        state.emplace(scope.resource(), queue_options);
+        restore(from);
+        run_events(time);
+        SimulationSnapshot snapshot = capture(time);
+        state.reset();
+        return snapshot;
+    }
+
+    // Run-length view of the last completed run, rows in input order
+    const SegmentTable& segments() const {
+        return segment_table;
+    }
+
+    // Counting is on by default. A run that does not count leaves
+    // counters() empty; resuming a snapshot taken without counting counts
+    // only the events after the pause.
+    void set_counting(bool on) {
+        counting = on;
+    }
+
+    // Per-process counters of the last completed run, in input order
+    const std::vector<ProcessCounters>& counters() const {
+        return counter_table;
+    }
+
+    // Totals of the last completed run
+    const RunCounters& run_counters() const {
+        return run_totals;
+    }
+
+    // Times every `every`th ready-queue insert and pick from the next run
+    // on; 0 (the default) times none. A resumed run only covers the ops
+    // after the pause.
+    void set_decision_sampling(uint32_t every) {
+        decision_sample_every = every;
+    }
+
+    // Decision latencies of the last run, in decision_clock() ticks
+    const DecisionLatency& decision_latency() const {
+        return latency_totals;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// The classic algorithms as policy combinations
+// ---------------------------------------------------------------------------
+using FcfsScheduler = Scheduler<FifoQueue, NonPreemptive, RunToCompletion>;
+using SjfScheduler = Scheduler<ShortestBurstQueue, NonPreemptive, RunToCompletion>;
+using RoundRobinScheduler = Scheduler<FifoQueue, NonPreemptive, FixedQuantum>;
+using MlfqScheduler = Scheduler<MultiLevelQueue, NonPreemptive, LevelQuantum>;
+using NonPreemptivePriorityScheduler = Scheduler<PriorityQueue, NonPreemptive, RunToCompletion>;
+using PreemptivePriorityScheduler = Scheduler<PriorityQueue, PreemptOnArrival, RunToCompletion>;
+using FcfsPreemptiveScheduler = Scheduler<ArrivalOrderQueue, PreemptOnArrival, RunToCompletion>;
+using SrtfScheduler = Scheduler<ShortestBurstQueue, PreemptOnArrival, RunToCompletion>;
+using HrrnScheduler = Scheduler<ResponseRatioQueue, NonPreemptive, RunToCompletion>;
+using LotteryScheduler = Scheduler<LotteryQueue, NonPreemptive, FixedQuantum>;
+using StrideScheduler = Scheduler<StrideQueue, NonPreemptive, FixedQuantum>;
+
+#endif
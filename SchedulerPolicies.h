@@ -0,0 +1,456 @@
+#ifndef SCHEDULER_POLICIES_H
+#define SCHEDULER_POLICIES_H
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <memory_resource>
+#include <queue>
+#include <vector>
+#include "ProcessCounters.h"
+#include "SimTime.h"
+
+// Runtime state the engine keeps for every process
+struct Task {
+    int index = 0;             // Position in the input process list
+    SimTime arrival{};
+    int priority = 0;
+    int phase = 0;             // 0: first CPU burst, 1: I/O, 2: second CPU burst, 3: done
+    SimTime remaining{};       // Left in the current CPU burst
+    int level = 0;             // Feedback-queue level (MLFQ)
+    SimTime ready_since{};     // When the task last entered the ready queue
+    int io_device = -1;
+    uint64_t pass = 0;         // Stride scheduling: virtual time consumed so far (wraps)
+    ProcessCounters counters;   // Filled in only when the engine is counting
+};
+
+// Settings some queue policies take (see LotteryQueue)
+struct QueueOptions {
+    uint64_t seed = 1;
+};
+
+// ---------------------------------------------------------------------------
+// Queue policies: decide which ready task runs next. The engine builds a
+// fresh queue for every run, drawing memory from the run arena.
+//
+//   explicit Queue(std::pmr::memory_resource* arena)
+//       or Queue(std::pmr::memory_resource* arena, const QueueOptions&)
+//   void push(const Task& task)
+//   int  pop()
+//   bool empty() const
+//   size_t size() const
+//   bool preempts(const Task& running) const
+//       true if the best ready task should displace the running one
+//       (only consulted by preemptive schedulers)
+//   void charge(Task& task, SimTime ran)
+//       the running task used `ran` units of CPU
+//
+// Queues with state of their own beyond the ready tasks also provide
+//   uint64_t save_state() const / void load_state(uint64_t)
+// so that it survives a pause (see SimulationSnapshot). Queues whose
+// choice depends on the clock provide
+//   int pop_at(SimTime now)
+// which the engine uses for dispatch; pop() then only has to drain.
+// ---------------------------------------------------------------------------
+
+// Ready order is arrival order into the queue
+class FifoQueue {
+private:
+    std::pmr::deque<int> ready;
+
+public:
+    explicit FifoQueue(std::pmr::memory_resource* arena = std::pmr::get_default_resource()) : ready(arena) {}
+
+    void push(const Task& task) { ready.push_back(task.index); }
+    int pop() { int t = ready.front(); ready.pop_front(); return t; }
+    bool empty() const { return ready.empty(); }
+    size_t size() const { return ready.size(); }
+    bool preempts(const Task&) const { return false; }
+    void charge(Task&, SimTime) {}
+};
+
+// Binary heap on a per-task key; ties go to whoever was queued first
+template <class KeyOf>
+class KeyedQueue {
+private:
+    struct Entry {
+        int64_t key;
+        uint64_t seq;
+        int task;
+        bool operator>(const Entry& other) const {
+            return key != other.key ? key > other.key : seq > other.seq;
+        }
+    };
+    std::priority_queue<Entry, std::pmr::vector<Entry>, std::greater<Entry>> heap;
+    uint64_t next_seq = 0;
+
+public:
+    explicit KeyedQueue(std::pmr::memory_resource* arena = std::pmr::get_default_resource())
+        : heap(std::greater<Entry>(), std::pmr::vector<Entry>(arena)) {}
+
+    void push(const Task& task) {
+        heap.push({KeyOf::key(task), next_seq++, task.index});
+    }
+    int pop() { int t = heap.top().task; heap.pop(); return t; }
+    bool empty() const { return heap.empty(); }
+    size_t size() const { return heap.size(); }
+    bool preempts(const Task& running) const {
+        return !heap.empty() && heap.top().key < KeyOf::key(running);
+    }
+    void charge(Task&, SimTime) {}
+};
+
+struct RemainingBurstKey {
+    static int64_t key(const Task& t) { return t.remaining.ticks(); }
+};
+
+struct PriorityKey {
+    static int64_t key(const Task& t) { return t.priority; }   // lower = higher priority
+};
+
+struct ArrivalKey {
+    static int64_t key(const Task& t) { return t.arrival.ticks(); }
+};
+
+using ShortestBurstQueue = KeyedQueue<RemainingBurstKey>;
+using PriorityQueue = KeyedQueue<PriorityKey>;
+using ArrivalOrderQueue = KeyedQueue<ArrivalKey>;
+
+// One FIFO per feedback level; the lowest non-empty level runs first
+class MultiLevelQueue {
+private:
+    std::pmr::vector<std::pmr::deque<int>> levels;   // Each level uses the vector's allocator
+    size_t count = 0;
+
+public:
+    explicit MultiLevelQueue(std::pmr::memory_resource* arena = std::pmr::get_default_resource()) : levels(arena) {}
+
+    void push(const Task& task) {
+        size_t level = task.level;
+        if (level >= levels.size()) levels.resize(level + 1);
+        levels[level].push_back(task.index);
+        count++;
+    }
+    int pop() {
+        for (auto& q : levels) {
+            if (!q.empty()) {
+                int t = q.front();
+                q.pop_front();
+                count--;
+                return t;
+            }
+        }
+        return -1;
+    }
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+    bool preempts(const Task& running) const {
+        for (int l = 0; l < running.level && l < (int)levels.size(); l++) {
+            if (!levels[l].empty()) return true;
+        }
+        return false;
+    }
+    void charge(Task&, SimTime) {}
+};
+
+// Highest Response Ratio Next: (wait + burst) / burst, so short jobs go
+// first but waiting raises everyone's ratio and nothing starves.
+//
+// Ready tasks are bucketed by burst: one bucket per length up to
+// kExactBursts, then kGrowth buckets per power of two, each at most
+// 1/kGrowth of its lower edge wide. A bucket is kept in ready order (a
+// task readied earlier than the tail, e.g. on restoring a snapshot, is
+// inserted in place), so its head has waited longest; among equal bursts
+// that is the best ratio. A dispatch compares the bucket heads
+// only, O(buckets) however many tasks are ready. Within a geometric bucket
+// a shorter, later task may beat the head, so the wait/burst part of the
+// chosen ratio is within a factor 1 + 1/kGrowth of the best; short bursts
+// are exact.
+class ResponseRatioQueue {
+private:
+    struct Entry {
+        int task;
+        SimTime ready_since;
+        SimTime burst;
+    };
+    std::pmr::vector<std::pmr::deque<Entry>> buckets;   // Each bucket uses the vector's allocator
+    size_t count = 0;
+
+    static constexpr int kExactOctave = 6;   // kExactBursts = 2^6
+    static constexpr int kGrowthBits = 4;    // kGrowth = 2^4
+
+    // From the bit width, as LatencyHistogram::bucket_of: the octave,
+    // then the kGrowthBits bits below the leading one
+    static size_t bucket_of(SimTime burst) {
+        int64_t ticks = burst.ticks();
+        if (ticks <= kExactBursts) return (size_t)std::max<int64_t>(ticks, 0);
+        int octave = 63 - __builtin_clzll((uint64_t)ticks);   // >= kExactOctave
+        size_t sub = (size_t)((uint64_t)ticks >> (octave - kGrowthBits)) & (kGrowth - 1);
+        return kExactBursts + 1 + (size_t)(octave - kExactOctave) * kGrowth + sub;
+    }
+
+    // Ratio comparison without division: w_a / b_a against w_b / b_b;
+    // ties go to the task that has been ready longer, then arrived first.
+    // The products take 128 bits, as 64-bit times would overflow them.
+    static bool better(const Entry& a, const Entry& b, SimTime now) {
+        __int128 lhs = (__int128)(now - a.ready_since).ticks() * std::max<int64_t>(b.burst.ticks(), 1);
+        __int128 rhs = (__int128)(now - b.ready_since).ticks() * std::max<int64_t>(a.burst.ticks(), 1);
+        if (lhs != rhs) return lhs > rhs;
+        if (a.ready_since != b.ready_since) return a.ready_since < b.ready_since;
+        return a.task < b.task;
+    }
+
+    int take(size_t bucket) {
+        int t = buckets[bucket].front().task;
+        buckets[bucket].pop_front();
+        count--;
+        return t;
+    }
+
+public:
+    static constexpr int kExactBursts = 64;
+    static constexpr int kGrowth = 16;
+    static_assert(kExactBursts == 1 << kExactOctave && kGrowth == 1 << kGrowthBits, "powers of two");
+
+    explicit ResponseRatioQueue(std::pmr::memory_resource* arena = std::pmr::get_default_resource())
+        : buckets(arena) {}
+
+    void push(const Task& task) {
+        size_t b = bucket_of(task.remaining);
+        if (b >= buckets.size()) buckets.resize(b + 1);
+        // Ready order; tasks readied at the same moment line up by arrival,
+        // as in better()
+        auto& bucket = buckets[b];
+        auto pos = bucket.end();
+        while (pos != bucket.begin() && (std::prev(pos)->ready_since > task.ready_since ||
+                                         (std::prev(pos)->ready_since == task.ready_since &&
+                                          std::prev(pos)->task > task.index))) {
+            --pos;
+        }
+        bucket.insert(pos, {task.index, task.ready_since, task.remaining});
+        count++;
+    }
+
+    int pop_at(SimTime now) {
+        size_t best = buckets.size();
+        for (size_t b = 0; b < buckets.size(); b++) {
+            if (buckets[b].empty()) continue;
+            if (best == buckets.size() || better(buckets[b].front(), buckets[best].front(), now)) best = b;
+        }
+        return take(best);
+    }
+
+    // Drains bucket by bucket, which keeps each bucket's order on restore
+    int pop() {
+        for (size_t b = 0; b < buckets.size(); b++) {
+            if (!buckets[b].empty()) return take(b);
+        }
+        return -1;
+    }
+
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+    bool preempts(const Task&) const { return false; }
+    void charge(Task&, SimTime) {}
+};
+
+// Proportional share: each ready task holds max(priority, 1) tickets and
+// a draw picks the winner with probability proportional to its tickets.
+// Tickets sit in a Fenwick tree indexed by task, so a draw is O(log n).
+// The random stream is seeded from QueueOptions and counts draws, so a
+// run is reproducible and a resumed run continues the same stream.
+class LotteryQueue {
+private:
+    std::pmr::vector<int64_t> tree;      // Fenwick tree, 1-based
+    std::pmr::vector<int64_t> tickets;   // Per task; 0 when not ready
+    int64_t total = 0;
+    size_t count = 0;
+    uint64_t seed;
+    uint64_t draws = 0;
+
+    static int64_t tickets_of(const Task& t) { return std::max(t.priority, 1); }
+
+    void add(size_t i, int64_t delta) {
+        for (size_t k = i + 1; k < tree.size(); k += k & (~k + 1)) tree[k] += delta;
+    }
+
+    // Doubles the tree and rebuilds it from the ticket counts in O(n)
+    void grow(size_t needed) {
+        size_t capacity = std::max<size_t>(tickets.size() * 2, 64);
+        while (capacity < needed) capacity *= 2;
+        tickets.resize(capacity, 0);
+        tree.assign(capacity + 1, 0);
+        for (size_t k = 1; k <= capacity; k++) {
+            tree[k] += tickets[k - 1];
+            size_t parent = k + (k & (~k + 1));
+            if (parent <= capacity) tree[parent] += tree[k];
+        }
+    }
+
+    // splitmix64 of the seed and draw number
+    uint64_t next_random() {
+        uint64_t z = seed + 0x9E3779B97F4A7C15ULL * ++draws;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+public:
+    explicit LotteryQueue(std::pmr::memory_resource* arena = std::pmr::get_default_resource(),
+                          const QueueOptions& options = QueueOptions())
+        : tree(arena), tickets(arena), seed(options.seed) {}
+
+    void push(const Task& task) {
+        size_t i = task.index;
+        if (i >= tickets.size()) grow(i + 1);
+        int64_t t = tickets_of(task);
+        tickets[i] = t;
+        add(i, t);
+        total += t;
+        count++;
+    }
+
+    int pop() {
+        // Winning ticket, then the first task whose running sum passes it
+        int64_t target = (int64_t)(next_random() % (uint64_t)total);
+        size_t pos = 0;
+        for (size_t step = tickets.size(); step > 0; step >>= 1) {   // A power of two
+            if (pos + step < tree.size() && tree[pos + step] <= target) {
+                pos += step;
+                target -= tree[pos];
+            }
+        }
+        int64_t t = tickets[pos];
+        tickets[pos] = 0;
+        add(pos, -t);
+        total -= t;
+        count--;
+        return (int)pos;
+    }
+
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+    bool preempts(const Task&) const { return false; }
+    void charge(Task&, SimTime) {}
+
+    uint64_t save_state() const { return draws; }
+    void load_state(uint64_t state) { draws = state; }
+};
+
+// Deterministic proportional share: every task advances a pass value by
+// kStrideOne / tickets per unit of CPU it uses, and the lowest pass runs
+// next. A task that (re)joins starts no earlier than the pass of the last
+// dispatch, so time spent away does not bank credit.
+//
+// A ticket-1 task's pass passes 2^63 after about 8.8e12 ticks of CPU (2.4
+// hours in nanoseconds), so passes are unsigned, wrap, and are compared by
+// their difference, as Linux CFS compares vruntime. A queued or charged
+// pass is never more than kMaxLead ahead of global_pass (one charge is
+// capped below it); a pass further off is a stale one, from before the
+// task went away, however long ago.
+class StrideQueue {
+private:
+    struct Entry {
+        uint64_t pass;
+        int task;
+        bool operator>(const Entry& other) const {
+            return pass != other.pass ? before(other.pass, pass) : task > other.task;
+        }
+    };
+    std::priority_queue<Entry, std::pmr::vector<Entry>, std::greater<Entry>> heap;
+    uint64_t global_pass = 0;
+
+    static constexpr uint64_t kMaxLead = uint64_t(1) << 62;
+
+    static bool before(uint64_t a, uint64_t b) { return (int64_t)(a - b) < 0; }
+
+    // Where a task with this pass stands now
+    uint64_t current(uint64_t pass) const { return pass - global_pass < kMaxLead ? pass : global_pass; }
+
+public:
+    static constexpr uint64_t kStrideOne = uint64_t(1) << 20;
+
+    // At least 1, so tasks with more than kStrideOne tickets still advance
+    // (they share the CPU evenly among themselves)
+    static uint64_t stride_of(const Task& t) {
+        return std::max<uint64_t>(kStrideOne / (uint64_t)std::max(t.priority, 1), 1);
+    }
+
+    explicit StrideQueue(std::pmr::memory_resource* arena = std::pmr::get_default_resource())
+        : heap(std::greater<Entry>(), std::pmr::vector<Entry>(arena)) {}
+
+    void push(const Task& task) { heap.push({current(task.pass), task.index}); }
+    int pop() {
+        Entry e = heap.top();
+        heap.pop();
+        global_pass = e.pass;
+        return e.task;
+    }
+    bool empty() const { return heap.empty(); }
+    size_t size() const { return heap.size(); }
+    bool preempts(const Task&) const { return false; }
+    void charge(Task& task, SimTime ran) {
+        uint64_t stride = stride_of(task);
+        uint64_t steps = std::min((uint64_t)std::max<int64_t>(ran.ticks(), 0), (kMaxLead - 1) / stride);
+        task.pass = current(task.pass) + steps * stride;
+    }
+
+    uint64_t save_state() const { return global_pass; }
+    void load_state(uint64_t state) { global_pass = state; }
+};
+
+// ---------------------------------------------------------------------------
+// Preemption policies: whether an arrival may displace the running task
+// ---------------------------------------------------------------------------
+
+struct NonPreemptive {
+    static constexpr bool on_arrival = false;
+};
+
+struct PreemptOnArrival {
+    static constexpr bool on_arrival = true;
+};
+
+// ---------------------------------------------------------------------------
+// Quantum policies: how long a dispatched task may run, and what happens
+// to it when that time runs out with work left.
+//
+//   SimTime slice(const Task& t) const   (<= t.remaining)
+//   void on_expire(Task& t) const
+// ---------------------------------------------------------------------------
+
+struct RunToCompletion {
+    SimTime slice(const Task& t) const { return t.remaining; }
+    void on_expire(Task&) const {}
+};
+
+struct FixedQuantum {
+    int quantum = 4;
+
+    FixedQuantum() = default;
+    explicit FixedQuantum(int q) : quantum(q) {}
+
+    SimTime slice(const Task& t) const { return std::min(SimTime(quantum), t.remaining); }
+    void on_expire(Task&) const {}
+};
+
+// Quantum grows with the feedback level; a task that uses its whole
+// quantum is demoted. Past the last quantum it runs to completion, like
+// the FCFS bottom queue of MLFQ.
+struct LevelQuantum {
+    std::vector<int> quanta = {8, 16};
+
+    LevelQuantum() = default;
+    explicit LevelQuantum(std::vector<int> q) : quanta(std::move(q)) {}
+
+    SimTime slice(const Task& t) const {
+        return t.level < (int)quanta.size() ? std::min(SimTime(quanta[t.level]), t.remaining) : t.remaining;
+    }
+    void on_expire(Task& t) const {
+        if (t.level < (int)quanta.size()) t.level++;
+    }
+};
+
+#endif
@@ -0,0 +1,184 @@
+#include "SchedulerRegistry.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include "Instrumentation.h"
+
+const ParamSpec* SchedulerInfo::find_param(const std::string& param) const {
+    for (const auto& p : params) {
+        if (p.name == param) return &p;
+    }
+    return nullptr;
+}
+
+bool SchedulerInfo::wants_default_quantum() const {
+    const ParamSpec* quantum = find_param("quantum");
+    return quantum != nullptr && quantum->default_value != 0;
+}
+
+SchedulerRegistry& SchedulerRegistry::instance() {
+    // Function-local so registrations from any translation unit see it
+    // constructed, whatever the static initialisation order
+    static SchedulerRegistry registry;
+    return registry;
+}
+
+bool SchedulerRegistry::add(SchedulerInfo info) {
+    auto pos = std::lower_bound(entries.begin(), entries.end(), info.name,
+                                [](const SchedulerInfo& e, const std::string& name) { return e.name < name; });
+    if (pos != entries.end() && pos->name == info.name) return false;
+    entries.insert(pos, std::move(info));
+    return true;
+}
+
+const SchedulerInfo* SchedulerRegistry::find(const std::string& name) const {
+    auto pos = std::lower_bound(entries.begin(), entries.end(), name,
+                                [](const SchedulerInfo& e, const std::string& n) { return e.name < n; });
+    if (pos == entries.end() || pos->name != name) return nullptr;
+    return &*pos;
+}
+
+const SchedulerInfo* SchedulerRegistry::prepare(const std::string& name, const SchedulerParams& params,
+                                                SchedulerParams& resolved, std::string& error) const {
+    const SchedulerInfo* info = find(name);
+    if (info == nullptr) {
+        error = "unknown algorithm " + name;
+        return nullptr;
+    }
+
+    for (const auto& kv : params.all()) {
+        if (info->find_param(kv.first) == nullptr) {
+            error = name + " has no parameter " + kv.first;
+            return nullptr;
+        }
+    }
+
+    for (const auto& spec : info->params) {
+        int value = params.get(spec.name, spec.default_value);
+        if (value < spec.min_value || value > spec.max_value) {
+            error = name + ": " + spec.name + " must be in [" + std::to_string(spec.min_value) + ", " +
+                    std::to_string(spec.max_value) + "]";
+            return nullptr;
+        }
+        resolved.set(spec.name, value);
+    }
+    return info;
+}
+
+bool SchedulerRegistry::run(const std::string& name, const std::vector<Process>& workload,
+                            const SchedulerParams& params, ScheduleSink& sink, std::string& error) const {
+    SchedulerParams resolved;
+    const SchedulerInfo* info = prepare(name, params, resolved, error);
+    if (info == nullptr) return false;
+
+    SCHED_TIME_SCOPE(Stage::Run);
+    info->run(workload, resolved, sink);
+    return true;
+}
+
+bool SchedulerRegistry::run_until(const std::string& name, const std::vector<Process>& workload,
+                                  const SchedulerParams& params, SimTime time, SimulationSnapshot& snapshot,
+                                  std::string& error) const {
+    SchedulerParams resolved;
+    const SchedulerInfo* info = prepare(name, params, resolved, error);
+    if (info == nullptr) return false;
+    if (!info->resumable()) {
+        error = name + " cannot pause; only policy-engine algorithms can";
+        return false;
+    }
+
+    SCHED_TIME_SCOPE(Stage::Run);
+    snapshot = info->resume_until(initial_snapshot(std::make_shared<const std::vector<Process>>(workload)),
+                                  resolved, time);
+    return true;
+}
+
+bool SchedulerRegistry::resume_until(const std::string& name, const SimulationSnapshot& snapshot,
+                                     const SchedulerParams& params, SimTime time, SimulationSnapshot& paused,
+                                     std::string& error) const {
+    SchedulerParams resolved;
+    const SchedulerInfo* info = prepare(name, params, resolved, error);
+    if (info == nullptr) return false;
+    if (!info->resumable()) {
+        error = name + " cannot resume a snapshot; only policy-engine algorithms can";
+        return false;
+    }
+    if (!snapshot.workload) {
+        error = "empty snapshot";
+        return false;
+    }
+
+    SCHED_TIME_SCOPE(Stage::Run);
+    paused = info->resume_until(snapshot, resolved, time);
+    return true;
+}
+
+bool SchedulerRegistry::resume(const std::string& name, const SimulationSnapshot& snapshot,
+                               const SchedulerParams& params, ScheduleSink& sink, std::string& error) const {
+    SchedulerParams resolved;
+    const SchedulerInfo* info = prepare(name, params, resolved, error);
+    if (info == nullptr) return false;
+    if (!info->resumable()) {
+        error = name + " cannot resume a snapshot; only policy-engine algorithms can";
+        return false;
+    }
+    if (!snapshot.workload) {
+        error = "empty snapshot";
+        return false;
+    }
+
+    SCHED_TIME_SCOPE(Stage::Run);
+    info->resume(snapshot, resolved, sink);
+    return true;
+}
+
+namespace {
+
+SchedulerInfo run_only_info(std::string name, std::string title, std::vector<ParamSpec> params, SchedulerRunFn run) {
+    SchedulerInfo info;
+    info.name = std::move(name);
+    info.title = std::move(title);
+    info.params = std::move(params);
+    info.run = std::move(run);
+    return info;
+}
+
+}  // namespace
+
+SchedulerRegistration::SchedulerRegistration(std::string name, std::string title, std::vector<ParamSpec> params,
+                                             SchedulerRunFn run)
+    : SchedulerRegistration(run_only_info(std::move(name), std::move(title), std::move(params), std::move(run))) {}
+
+SchedulerRegistration::SchedulerRegistration(SchedulerInfo info) {
+    std::string name = info.name;
+    if (!SchedulerRegistry::instance().add(std::move(info))) {
+        std::cerr << "SchedulerRegistry: duplicate algorithm " << name << "\n";
+    }
+}
+
+bool parse_scheduler_params(const std::string& text, SchedulerParams& params, std::string& error) {
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (item.empty()) continue;
+        size_t eq = item.find('=');
+        if (eq == std::string::npos || eq == 0 || eq + 1 == item.size()) {
+            error = "expected name=value, got \"" + item + "\"";
+            return false;
+        }
+        std::string value = item.substr(eq + 1);
+        char* end = nullptr;
+        errno = 0;
+        long v = std::strtol(value.c_str(), &end, 10);
+        if (*end != '\0' || errno == ERANGE || v < INT_MIN || v > INT_MAX) {
+            error = "not an integer: \"" + value + "\"";
+            return false;
+        }
+        params.set(item.substr(0, eq), (int)v);
+    }
+    return true;
+}
@@ -0,0 +1,189 @@
+#ifndef SCHEDULER_REGISTRY_H
+#define SCHEDULER_REGISTRY_H
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+#include "Process.h"
+#include "ProcessGrantInfo.h"
+#include "CpuConstraints.h"
+#include "DecisionLatency.h"
+#include "MultiCpuStats.h"
+#include "ProcessCounters.h"
+#include "Segment.h"
+#include "SimulationSnapshot.h"
+
+// Runtime catalogue of scheduling algorithms. Each algorithm registers
+// itself by name (see the SchedulerRegistration objects at the bottom of
+// fcfs.cpp, rr.cpp, ...), together with the integer parameters it accepts,
+// so drivers can list and run every scheduler without naming any of them.
+
+// One tunable of an algorithm, e.g. the Round Robin quantum
+struct ParamSpec {
+    std::string name;
+    std::string description;
+    int default_value = 0;
+    int min_value = 0;
+    int max_value = 0;
+};
+
+// Parameter values by name; anything not set takes the schema default
+class SchedulerParams {
+private:
+    std::map<std::string, int> values;
+
+public:
+    void set(const std::string& name, int value) { values[name] = value; }
+    bool has(const std::string& name) const { return values.count(name) != 0; }
+    int get(const std::string& name, int fallback = 0) const {
+        auto it = values.find(name);
+        return it == values.end() ? fallback : it->second;
+    }
+    const std::map<std::string, int>& all() const { return values; }
+};
+
+// Receives the result of a run. Schedulers that track individual slices
+// and scheduling events (the Scheduler<> engine) also report them through
+// segments() and counters(). Events are only counted for sinks that ask
+// for them with wants_counters(), and decisions only timed for sinks that
+// ask with decision_sample_every() (the engines and the legacy priority
+// and SJF schedulers report them). Multi-CPU schedulers (MultiCpu.h) also
+// report machine-level totals through multi_cpu(), and honour the affinity
+// and bandwidth limits a sink gives through cpu_constraints().
+class ScheduleSink {
+public:
+    virtual ~ScheduleSink() = default;
+    virtual void chart(const std::vector<ProcessGrantInfo>& records) = 0;
+    virtual void segments(const SegmentTable&) {}
+    virtual bool wants_counters() const { return false; }
+    virtual void counters(const std::vector<ProcessCounters>&, const RunCounters&) {}
+    // N > 0 asks Scheduler<> engines to time every Nth ready-queue op
+    virtual uint32_t decision_sample_every() const { return 0; }
+    virtual void decision_latency(const DecisionLatency&) {}
+    virtual void multi_cpu(const MultiCpuStats&) {}
+    virtual const CpuConstraints* cpu_constraints() const { return nullptr; }
+};
+
+// Sink that keeps everything it is given
+class ScheduleCollector : public ScheduleSink {
+public:
+    std::vector<ProcessGrantInfo> records;
+    SegmentTable slices;
+    bool has_slices = false;
+    std::vector<ProcessCounters> process_counters;   // Input order
+    RunCounters run_counters;
+    bool has_counters = false;
+    bool collect_counters = true;
+    DecisionLatency latency;
+    bool has_latency = false;
+    uint32_t latency_sample_every = 0;   // Off by default: timing costs two clock reads per op
+    MultiCpuStats cpu_stats;
+    bool has_cpu_stats = false;
+    const CpuConstraints* constraints = nullptr;   // Not owned
+
+    void chart(const std::vector<ProcessGrantInfo>& r) override { records = r; }
+    void segments(const SegmentTable& table) override {
+        slices = table;
+        has_slices = true;
+    }
+    bool wants_counters() const override { return collect_counters; }
+    void counters(const std::vector<ProcessCounters>& c, const RunCounters& totals) override {
+        process_counters = c;
+        run_counters = totals;
+        has_counters = true;
+    }
+    uint32_t decision_sample_every() const override { return latency_sample_every; }
+    void decision_latency(const DecisionLatency& l) override {
+        latency = l;
+        has_latency = true;
+    }
+    void multi_cpu(const MultiCpuStats& stats) override {
+        cpu_stats = stats;
+        has_cpu_stats = true;
+    }
+    const CpuConstraints* cpu_constraints() const override { return constraints; }
+};
+
+using SchedulerRunFn = std::function<void(const std::vector<Process>&, const SchedulerParams&, ScheduleSink&)>;
+using SchedulerPauseFn = std::function<SimulationSnapshot(const SimulationSnapshot&, const SchedulerParams&, SimTime)>;
+using SchedulerResumeFn = std::function<void(const SimulationSnapshot&, const SchedulerParams&, ScheduleSink&)>;
+
+struct SchedulerInfo {
+    std::string name;                 // Command-line name, e.g. "rr"
+    std::string title;                // Human-readable name for menus and reports
+    std::vector<ParamSpec> params;
+    SchedulerRunFn run;
+
+    // Only Scheduler<> engines (policy-*, lottery, stride) can pause and
+    // resume; empty for the others
+    SchedulerPauseFn resume_until = nullptr;
+    SchedulerResumeFn resume = nullptr;
+
+    bool resumable() const { return resume_until && resume; }
+
+    const ParamSpec* find_param(const std::string& param) const;
+
+    // Whether a driver's default quantum applies: the algorithm has a
+    // "quantum" parameter whose own default is not 0 (for smp and gang, 0
+    // means no time slicing, and a slice has to be asked for)
+    bool wants_default_quantum() const;
+};
+
+class SchedulerRegistry {
+private:
+    std::vector<SchedulerInfo> entries;
+
+    // Checks params against the schema and fills in defaults
+    const SchedulerInfo* prepare(const std::string& name, const SchedulerParams& params,
+                                 SchedulerParams& resolved, std::string& error) const;
+
+public:
+    static SchedulerRegistry& instance();
+
+    // Fails (returns false) if the name is already taken
+    bool add(SchedulerInfo info);
+
+    const SchedulerInfo* find(const std::string& name) const;
+
+    // Sorted by name so listings do not depend on link order
+    const std::vector<SchedulerInfo>& all() const { return entries; }
+
+    // Checks params against the schema, fills in defaults and runs the
+    // algorithm. Returns false with a message for unknown algorithms,
+    // unknown parameters or out-of-range values.
+    bool run(const std::string& name, const std::vector<Process>& workload,
+             const SchedulerParams& params, ScheduleSink& sink, std::string& error) const;
+
+    // Runs from time 0 and pauses before `time` (see Scheduler::run_until)
+    bool run_until(const std::string& name, const std::vector<Process>& workload, const SchedulerParams& params,
+                   SimTime time, SimulationSnapshot& snapshot, std::string& error) const;
+
+    // Continues a snapshot and pauses again before `time`
+    bool resume_until(const std::string& name, const SimulationSnapshot& snapshot, const SchedulerParams& params,
+                      SimTime time, SimulationSnapshot& paused, std::string& error) const;
+
+    // Finishes a snapshot under this algorithm. Safe to call from several
+    // threads on the same snapshot.
+    bool resume(const std::string& name, const SimulationSnapshot& snapshot,
+                const SchedulerParams& params, ScheduleSink& sink, std::string& error) const;
+};
+
+// Registers an algorithm during static initialisation:
+//
+//   namespace {
+//   const SchedulerRegistration registration("fcfs", "First Come First Served", {}, run_fcfs);
+//   }
+//
+// Entries that can also pause and resume build a whole SchedulerInfo (see
+// engine_entry in Scheduler.cpp).
+struct SchedulerRegistration {
+    explicit SchedulerRegistration(SchedulerInfo info);
+    SchedulerRegistration(std::string name, std::string title, std::vector<ParamSpec> params, SchedulerRunFn run);
+};
+
+// Parses "name=value[,name=value...]" into params. Returns false with a
+// message on malformed input; names are checked later by run().
+bool parse_scheduler_params(const std::string& text, SchedulerParams& params, std::string& error);
+
+#endif
@@ -0,0 +1,86 @@
+#include "Segment.h"
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <queue>
+#include <unordered_map>
+
+namespace {
+
+// Greedy lanes for the segments of one kind: the lowest free one per segment
+void assign_resources(std::vector<Segment>& segments, SegmentKind kind) {
+    std::vector<size_t> order;
+    for (size_t i = 0; i < segments.size(); i++) {
+        if (segments[i].kind == kind) order.push_back(i);
+    }
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return segments[a].start < segments[b].start;
+    });
+    using Busy = std::pair<SimTime, int>;   // (end, resource)
+    std::priority_queue<Busy, std::vector<Busy>, std::greater<Busy>> busy;
+    std::priority_queue<int, std::vector<int>, std::greater<int>> free_resources;
+    int used = 0;
+    for (size_t i : order) {
+        Segment& s = segments[i];
+        while (!busy.empty() && busy.top().first <= s.start) {
+            free_resources.push(busy.top().second);
+            busy.pop();
+        }
+        if (free_resources.empty()) free_resources.push(used++);
+        s.resource = free_resources.top();
+        free_resources.pop();
+        busy.push({s.end, s.resource});
+    }
+}
+
+}  // namespace
+
+SegmentTable segments_from_chart(const std::vector<ProcessGrantInfo>& chart) {
+    SegmentTable table;
+    std::unordered_map<std::string, int> row_of;
+    row_of.reserve(chart.size());
+    table.segments.reserve(chart.size() * 3);
+
+    auto add = [&](int row, SegmentKind kind, SimTime start, SimTime end) {
+        if (start < SimTime(0) || end <= start) return;
+        table.segments.emplace_back(row, 0, kind, start, end);
+        table.end_time = std::max(table.end_time, end);
+    };
+
+    for (const auto& info : chart) {
+        auto it = row_of.find(info.process.pid);
+        if (it == row_of.end()) {
+            it = row_of.emplace(info.process.pid, (int)table.rows.size()).first;
+            table.rows.push_back(info.process.pid);
+        }
+        int row = it->second;
+
+        add(row, SegmentKind::Cpu, info.cpu_start_time1, info.cpu_end_time1);
+        add(row, SegmentKind::Io, info.io_start_time, info.io_end_time);
+        add(row, SegmentKind::Cpu, info.cpu_start_time2, info.cpu_end_time2);
+    }
+
+    // Rows are listed by process ID, not by first appearance
+    std::vector<int> order(table.rows.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        return table.rows[a] < table.rows[b];
+    });
+
+    std::vector<int> new_index(order.size());
+    std::vector<std::string> sorted_rows(order.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        new_index[order[i]] = (int)i;
+        sorted_rows[i] = std::move(table.rows[order[i]]);
+    }
+    table.rows = std::move(sorted_rows);
+
+    for (auto& s : table.segments) {
+        s.row = new_index[s.row];
+    }
+
+    assign_resources(table.segments, SegmentKind::Cpu);
+    assign_resources(table.segments, SegmentKind::Io);
+    return table;
+}
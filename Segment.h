@@ -0,0 +1,42 @@
+#ifndef SEGMENT_H
+#define SEGMENT_H
+
+#include <string>
+#include <vector>
+#include "ProcessGrantInfo.h"
+
+// What a process is doing during a segment
+enum class SegmentKind : unsigned char {
+    Cpu,
+    Io
+};
+
+// One contiguous run of a process on a CPU or an I/O device
+struct Segment {
+    int row;            // Index into the row (process) list
+    int resource;       // CPU number or I/O device number, depending on kind
+    SegmentKind kind;
+    SimTime start;      // Inclusive
+    SimTime end;        // Exclusive
+
+    Segment() : row(0), resource(0), kind(SegmentKind::Cpu), start(0), end(0) {}
+
+    Segment(int r, int res, SegmentKind k, SimTime s, SimTime e)
+        : row(r), resource(res), kind(k), start(s), end(e) {}
+};
+
+// Run-length view of a schedule: one row per distinct process
+struct SegmentTable {
+    std::vector<std::string> rows;   // Process IDs, sorted
+    std::vector<Segment> segments;
+    SimTime end_time{};              // Largest segment end
+};
+
+// Flattens Gantt records into segments. Records that belong to the same
+// process (RR, MLFQ and FCFSPreemp emit several) share one row. Overlapping
+// segments get separate resources: each segment, in order of start, takes
+// the lowest-numbered device (or CPU) of its kind free at its start, as in
+// Scheduler.h. Charts of one CPU with non-overlapping I/O stay on 0.
+SegmentTable segments_from_chart(const std::vector<ProcessGrantInfo>& chart);
+
+#endif
@@ -0,0 +1,115 @@
+#include "ShareReport.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <string>
+#include <unordered_map>
+
+namespace {
+
+struct Interval {
+    SimTime start;
+    SimTime end;
+};
+
+int tickets_of(const Process& p) { return std::max(p.priority, 1); }
+
+void add_process(ShareClass& c, double entitled, double received) {
+    c.processes++;
+    c.entitled += entitled;
+    c.received += received;
+    if (entitled > 0) {
+        double error = std::fabs(received - entitled) / entitled;
+        c.mean_abs_error += error;   // Divided by the count in finish()
+        c.max_abs_error = std::max(c.max_abs_error, error);
+    }
+}
+
+void finish(ShareClass& c) {
+    if (c.processes > 0) c.mean_abs_error /= c.processes;
+    if (c.entitled > 0) c.relative_error = (c.received - c.entitled) / c.entitled;
+}
+
+}  // namespace
+
+ShareReport share_report(const SegmentTable& schedule, const std::vector<Process>& processes) {
+    std::unordered_map<std::string, const Process*> by_pid;
+    by_pid.reserve(processes.size());
+    for (const auto& p : processes) by_pid.emplace(p.pid, &p);
+
+    // Segments of each row in time order
+    std::vector<std::vector<const Segment*>> rows(schedule.rows.size());
+    for (const auto& s : schedule.segments) rows[s.row].push_back(&s);
+
+    // Runnable intervals and CPU time of every row with a known process
+    std::vector<const Process*> row_process(rows.size(), nullptr);
+    std::vector<std::vector<Interval>> runnable(rows.size());
+    std::vector<double> received(rows.size(), 0);
+    std::map<SimTime, long long> ticket_changes;   // time -> change in runnable tickets
+    for (size_t r = 0; r < rows.size(); r++) {
+        auto it = by_pid.find(schedule.rows[r]);
+        if (it == by_pid.end() || rows[r].empty()) continue;
+        row_process[r] = it->second;
+        auto& segs = rows[r];
+        std::sort(segs.begin(), segs.end(), [](const Segment* a, const Segment* b) { return a->start < b->start; });
+
+        SimTime start = it->second->arrival_time;
+        SimTime last_cpu_end = start;
+        for (const Segment* s : segs) {
+            if (s->kind == SegmentKind::Cpu) {
+                received[r] += (s->end - s->start).ticks();
+                last_cpu_end = std::max(last_cpu_end, s->end);
+            } else {
+                if (s->start > start) runnable[r].push_back({start, s->start});
+                start = std::max(start, s->end);
+            }
+        }
+        if (last_cpu_end > start) runnable[r].push_back({start, last_cpu_end});
+
+        int tickets = tickets_of(*it->second);
+        for (const auto& iv : runnable[r]) {
+            ticket_changes[iv.start] += tickets;
+            ticket_changes[iv.end] -= tickets;
+        }
+    }
+
+    // Entitlement per ticket accumulated up to each change: the integral
+    // of 1 / (runnable tickets) over time
+    std::vector<std::pair<SimTime, double>> per_ticket;
+    per_ticket.reserve(ticket_changes.size());
+    long long tickets = 0;
+    double accumulated = 0;
+    SimTime previous{};
+    for (const auto& change : ticket_changes) {
+        if (tickets > 0) accumulated += double((change.first - previous).ticks()) / tickets;
+        per_ticket.push_back({change.first, accumulated});
+        tickets += change.second;
+        previous = change.first;
+    }
+    auto at = [&](SimTime time) {
+        auto pos = std::lower_bound(per_ticket.begin(), per_ticket.end(), std::make_pair(time, -1.0));
+        return pos->second;
+    };
+
+    ShareReport report;
+    std::map<int, ShareClass> classes;
+    for (size_t r = 0; r < rows.size(); r++) {
+        if (row_process[r] == nullptr) continue;
+        int t = tickets_of(*row_process[r]);
+        double entitled = 0;
+        for (const auto& iv : runnable[r]) entitled += t * (at(iv.end) - at(iv.start));
+
+        ShareClass& c = classes[t];
+        c.tickets = t;
+        add_process(c, entitled, received[r]);
+        add_process(report.overall, entitled, received[r]);
+    }
+
+    finish(report.overall);
+    for (auto& kv : classes) {
+        finish(kv.second);
+        report.classes.push_back(kv.second);
+    }
+    return report;
+}
@@ -0,0 +1,38 @@
+#ifndef SHARE_REPORT_H
+#define SHARE_REPORT_H
+
+#include <vector>
+#include "Process.h"
+#include "Segment.h"
+
+// How closely a schedule gave each process its proportional share of the
+// CPU, with max(priority, 1) as the process's tickets (the weight lottery
+// and stride scheduling use).
+//
+// While a process is runnable (arrived, not doing I/O, not finished) it is
+// entitled to tickets / (tickets of all runnable processes) of the CPU.
+// Its entitlement is that rate integrated over its runnable time; what it
+// received is its CPU time. The error of a process is
+// (received - entitled) / entitled.
+
+// Processes with the same number of tickets
+struct ShareClass {
+    int tickets = 0;             // 0 for the row covering every process
+    size_t processes = 0;
+    double entitled = 0;
+    double received = 0;
+    double relative_error = 0;   // (received - entitled) / entitled for the class as a whole
+    double mean_abs_error = 0;   // Mean |error| of its processes
+    double max_abs_error = 0;
+};
+
+struct ShareReport {
+    ShareClass overall;
+    std::vector<ShareClass> classes;   // By ticket count, ascending
+};
+
+// Segments may come from a scheduler or from segments_from_chart(); rows
+// are matched to processes by ID
+ShareReport share_report(const SegmentTable& schedule, const std::vector<Process>& processes);
+
+#endif
@@ -0,0 +1,154 @@
+#ifndef SIM_TIME_H
+#define SIM_TIME_H
+
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+// Simulated time in ticks. 64 bits so that traces recorded in nanoseconds
+// or microseconds (hours of activity) fit, and so that times can be added
+// without the int overflow the old representation hit after ~35 minutes
+// of microseconds.
+//
+// A distinct type rather than an integer, so that a time does not mix
+// silently with counts, sizes or indexes: it is built explicitly from a
+// tick count (SimTime(5)) and read back with ticks(). Times add and
+// subtract, scale by plain numbers, and divide into a plain ratio; like
+// std::chrono::duration, everything is inline and constexpr, so it
+// compiles to the same code as the int64_t it holds.
+class SimTime {
+public:
+    using rep = std::int64_t;
+
+    constexpr SimTime() = default;
+    constexpr explicit SimTime(rep ticks) : value(ticks) {}
+
+    constexpr rep ticks() const { return value; }
+
+    constexpr SimTime operator-() const { return SimTime(-value); }
+    constexpr SimTime& operator+=(SimTime other) { value += other.value; return *this; }
+    constexpr SimTime& operator-=(SimTime other) { value -= other.value; return *this; }
+    constexpr SimTime& operator*=(rep k) { value *= k; return *this; }
+    constexpr SimTime& operator/=(rep k) { value /= k; return *this; }
+    constexpr SimTime& operator++() { ++value; return *this; }
+    constexpr SimTime& operator--() { --value; return *this; }
+    constexpr SimTime operator++(int) { return SimTime(value++); }
+    constexpr SimTime operator--(int) { return SimTime(value--); }
+
+    friend constexpr SimTime operator+(SimTime a, SimTime b) { return SimTime(a.value + b.value); }
+    friend constexpr SimTime operator-(SimTime a, SimTime b) { return SimTime(a.value - b.value); }
+    friend constexpr SimTime operator*(SimTime a, rep k) { return SimTime(a.value * k); }
+    friend constexpr SimTime operator*(rep k, SimTime a) { return SimTime(k * a.value); }
+    friend constexpr SimTime operator/(SimTime a, rep k) { return SimTime(a.value / k); }
+    friend constexpr rep operator/(SimTime a, SimTime b) { return a.value / b.value; }   // Whole b's in a
+    friend constexpr SimTime operator%(SimTime a, SimTime b) { return SimTime(a.value % b.value); }
+
+    friend constexpr bool operator==(SimTime a, SimTime b) { return a.value == b.value; }
+    friend constexpr bool operator!=(SimTime a, SimTime b) { return a.value != b.value; }
+    friend constexpr bool operator<(SimTime a, SimTime b) { return a.value < b.value; }
+    friend constexpr bool operator<=(SimTime a, SimTime b) { return a.value <= b.value; }
+    friend constexpr bool operator>(SimTime a, SimTime b) { return a.value > b.value; }
+    friend constexpr bool operator>=(SimTime a, SimTime b) { return a.value >= b.value; }
+
+    friend std::ostream& operator<<(std::ostream& out, SimTime t) { return out << t.value; }
+    friend std::istream& operator>>(std::istream& in, SimTime& t) { return in >> t.value; }
+
+private:
+    rep value = 0;
+};
+
+static_assert(std::is_trivially_copyable<SimTime>::value && sizeof(SimTime) == sizeof(SimTime::rep),
+              "SimTime must stay a plain 64-bit value");
+
+constexpr SimTime kSimTimeMax = SimTime(std::numeric_limits<SimTime::rep>::max());
+constexpr SimTime kSimTimeMin = SimTime(std::numeric_limits<SimTime::rep>::min());
+
+// What one tick stands for. It only matters when times are reported in
+// real units (throughput per second, trace timestamps); the schedulers
+// work in ticks.
+enum class TimeUnit { Nanoseconds, Microseconds, Milliseconds };
+
+constexpr double ticks_per_second(TimeUnit unit) {
+    return unit == TimeUnit::Nanoseconds ? 1e9 : unit == TimeUnit::Microseconds ? 1e6 : 1e3;
+}
+
+constexpr double microseconds_per_tick(TimeUnit unit) {
+    return 1e6 / ticks_per_second(unit);
+}
+
+inline const char* time_unit_name(TimeUnit unit) {
+    return unit == TimeUnit::Nanoseconds ? "ns" : unit == TimeUnit::Microseconds ? "us" : "ms";
+}
+
+// Accepts "ns", "us" and "ms"
+inline bool parse_time_unit(const std::string& text, TimeUnit& unit) {
+    if (text == "ns") unit = TimeUnit::Nanoseconds;
+    else if (text == "us") unit = TimeUnit::Microseconds;
+    else if (text == "ms") unit = TimeUnit::Milliseconds;
+    else return false;
+    return true;
+}
+
+// Exact sum of SimTime values (or of their tick counts), kept in 128 bits (high word signed, low
+// word unsigned) so no realistic number of 64-bit times overflows it.
+// value() says whether the sum fits back into a SimTime.
+class TimeSum {
+private:
+    int64_t high = 0;
+    uint64_t low = 0;
+
+public:
+    TimeSum() = default;
+    TimeSum(int64_t high_word, uint64_t low_word) : high(high_word), low(low_word) {}
+
+    void add(int64_t ticks) {
+        uint64_t u = (uint64_t)ticks;
+        low += u;
+        high += (low < u ? 1 : 0) - (ticks < 0 ? 1 : 0);
+    }
+    void add(SimTime t) { add(t.ticks()); }
+
+    void add_unsigned(uint64_t u) {
+        low += u;
+        high += low < u ? 1 : 0;
+    }
+
+    TimeSum& operator+=(const TimeSum& other) {
+        low += other.low;
+        high += other.high + (low < other.low ? 1 : 0);
+        return *this;
+    }
+
+    TimeSum& operator-=(const TimeSum& other) {
+        int64_t borrow = low < other.low ? 1 : 0;
+        low -= other.low;
+        high -= other.high + borrow;
+        return *this;
+    }
+
+    friend TimeSum operator+(TimeSum a, const TimeSum& b) { return a += b; }
+    friend TimeSum operator-(TimeSum a, const TimeSum& b) { return a -= b; }
+    bool operator==(const TimeSum& other) const { return high == other.high && low == other.low; }
+    bool operator!=(const TimeSum& other) const { return !(*this == other); }
+
+    // The sum as a SimTime; false (with `out` saturated) if it does not fit
+    bool value(SimTime& out) const {
+        if (high == 0 && low <= (uint64_t)kSimTimeMax.ticks()) {
+            out = SimTime((int64_t)low);
+            return true;
+        }
+        if (high == -1 && low > (uint64_t)kSimTimeMax.ticks()) {
+            out = SimTime((int64_t)low);
+            return true;
+        }
+        out = high < 0 ? kSimTimeMin : kSimTimeMax;
+        return false;
+    }
+
+    double as_double() const { return (double)high * 18446744073709551616.0 + (double)low; }
+};
+
+#endif
@@ -0,0 +1,38 @@
+#include "SimulationSnapshot.h"
+
+#include <algorithm>
+#include <numeric>
+
+int SimulationSnapshot::admit_next() {
+    int rank = (int)next_arrival++;
+    const Process& p = process(rank);
+    Task t;
+    t.index = rank;
+    t.arrival = p.arrival_time;
+    t.priority = p.priority;
+    t.remaining = p.cpu_burst_time1;
+    tasks.push_back(t);
+    const SimTime unset(-1);   // Fixed as the task runs
+    chart.push_back(ProcessGrantInfo(p, unset, unset, unset, unset, unset, unset));
+    return rank;
+}
+
+std::vector<int> arrival_order_of(const std::vector<Process>& workload) {
+    std::vector<int> order(workload.size());
+    std::iota(order.begin(), order.end(), 0);
+    // Ties keep input order; comparing indices avoids stable_sort's heap buffer
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        SimTime ta = workload[a].arrival_time, tb = workload[b].arrival_time;
+        return ta != tb ? ta < tb : a < b;
+    });
+    return order;
+}
+
+SimulationSnapshot initial_snapshot(std::shared_ptr<const std::vector<Process>> workload) {
+    SimulationSnapshot sim;
+    sim.arrival_order = std::make_shared<const std::vector<int>>(arrival_order_of(*workload));
+    sim.tasks.reserve(workload->size());
+    sim.chart.reserve(workload->size());
+    sim.workload = std::move(workload);
+    return sim;
+}
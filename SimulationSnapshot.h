@@ -0,0 +1,80 @@
+#ifndef SIMULATION_SNAPSHOT_H
+#define SIMULATION_SNAPSHOT_H
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "Process.h"
+#include "ProcessGrantInfo.h"
+#include "Segment.h"
+#include "CowArray.h"
+#include "SchedulerPolicies.h"
+
+// Complete state of a Scheduler<> run paused at `time`: all events before
+// that time have been handled. It does not depend on the policies that
+// produced it, so any Scheduler<> over the same workload can resume from
+// it, which is how one prefix forks into several what-if continuations.
+//
+// Tasks are numbered by arrival rank (position in arrival_order) and only
+// the processes that have arrived so far have runtime state. A snapshot
+// therefore stays valid when processes arriving at or after `time` are
+// edited, added or removed; only workload and arrival_order need replacing
+// (see IncrementalSimulation).
+//
+// Snapshots are cheap to copy: the workload and arrival order are shared,
+// and the per-task arrays are copy-on-write. A snapshot is read-only once
+// taken and can be resumed from several threads at once.
+struct SimulationSnapshot {
+    std::shared_ptr<const std::vector<Process>> workload;
+    std::shared_ptr<const std::vector<int>> arrival_order;   // Workload indices by arrival time
+
+    CowArray<Task> tasks;                // By arrival rank, arrived tasks only
+    CowArray<ProcessGrantInfo> chart;    // Same numbering, filled in as tasks run
+    CowArray<Segment> segments;          // CPU and I/O slices so far; rows are ranks
+    SimTime segment_end_time{};
+
+    SimTime time{};
+    size_t next_arrival = 0;             // == tasks.size()
+    int completed = 0;
+
+    // The slice in progress runs to its end, whatever policy resumes
+    int running = -1;
+    SimTime slice_start{};
+    SimTime slice_end{};
+
+    int last_on_cpu = -1;                // Task that held the CPU most recently
+    long long context_switches = 0;
+
+    std::vector<int> ready;                       // Ready tasks, best first for the policy that paused
+    std::vector<std::pair<SimTime, int>> io_pending;  // (completion time, task)
+    std::vector<int> free_io_devices;
+    int io_devices_used = 0;
+
+    // State the queue policy keeps of its own (lottery draws, stride pass),
+    // restored only into the same policy
+    size_t queue_policy = 0;
+    uint64_t queue_state = 0;
+
+    bool finished() const { return completed == (int)workload->size(); }
+
+    const Process& process(int rank) const { return (*workload)[(*arrival_order)[rank]]; }
+
+    // Arrival time of the next process, or false once all have arrived
+    bool next_arrival_time(SimTime& at) const {
+        if (next_arrival >= arrival_order->size()) return false;
+        at = process((int)next_arrival).arrival_time;
+        return true;
+    }
+
+    // Creates runtime state for the next process to arrive; returns its rank
+    int admit_next();
+};
+
+// Workload indices sorted by arrival time, ties in input order
+std::vector<int> arrival_order_of(const std::vector<Process>& workload);
+
+// State at time 0, before anything has arrived
+SimulationSnapshot initial_snapshot(std::shared_ptr<const std::vector<Process>> workload);
+
+#endif
@@ -0,0 +1,27 @@
+#include "Topology.h"
+
+#include <algorithm>
+
+CpuTopology CpuTopology::uniform(int cpu_count, int sockets, int smt, int llcs) {
+    CpuTopology topology;
+    cpu_count = std::max(cpu_count, 1);
+    smt = std::max(smt, 1);
+    int cores = (cpu_count + smt - 1) / smt;
+    topology.sockets = std::max(1, std::min(sockets, cores));
+    topology.threads_per_core = smt;
+    topology.llcs_per_socket = std::max(llcs, 1);
+
+    topology.cpus.resize(cpu_count);
+    for (int c = 0; c < cpu_count; c++) {
+        Cpu& cpu = topology.cpus[c];
+        cpu.core = c / smt;
+        cpu.sibling = c % smt;
+        cpu.node = (int)((long long)cpu.core * topology.sockets / cores);
+        // Cores of this node, to split them between its caches
+        int first = (int)(((long long)cpu.node * cores + topology.sockets - 1) / topology.sockets);
+        int next = (int)(((long long)(cpu.node + 1) * cores + topology.sockets - 1) / topology.sockets);
+        int groups = std::min(topology.llcs_per_socket, next - first);
+        cpu.llc = cpu.node * topology.llcs_per_socket + (int)((long long)(cpu.core - first) * groups / (next - first));
+    }
+    return topology;
+}
@@ -0,0 +1,41 @@
+#ifndef TOPOLOGY_H
+#define TOPOLOGY_H
+
+#include <vector>
+
+// Layout of a multi-socket machine for the multi-CPU model (MultiCpu.h).
+// Each socket is one NUMA node with its own memory; its cores are split
+// into groups sharing a last-level cache, and each core has one or more
+// SMT siblings. CPUs are numbered socket by socket, core by core, with a
+// core's siblings adjacent.
+struct CpuTopology {
+    struct Cpu {
+        int node = 0;     // Socket / NUMA node
+        int llc = 0;      // Shared last-level cache, numbered machine-wide
+        int core = 0;     // Physical core, numbered machine-wide
+        int sibling = 0;  // SMT thread within the core
+    };
+
+    int sockets = 1;
+    int threads_per_core = 1;
+    int llcs_per_socket = 1;
+    std::vector<Cpu> cpus;
+
+    int size() const { return (int)cpus.size(); }
+    int nodes() const { return sockets; }
+    bool empty() const { return cpus.empty(); }
+
+    // `cpu_count` CPUs spread as evenly as possible over the sockets, cores
+    // of `smt` siblings each, and `llcs` cache groups per socket
+    static CpuTopology uniform(int cpu_count, int sockets, int smt = 1, int llcs = 1);
+};
+
+// Where a process's memory lives, which decides how much of its running
+// time is spent on remote accesses
+enum class MemoryPlacement {
+    FirstTouch,   // On the node of the CPU its first thread first runs on
+    Interleave,   // Spread over all nodes: the same mix of local and remote from any CPU
+    NodeAffine    // On a node chosen at arrival (round robin), whose CPUs its threads prefer
+};
+
+#endif
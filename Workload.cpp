@@ -0,0 +1,257 @@
+#include "Workload.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+namespace {
+
+const char kBinaryMagic[8] = {'S', 'C', 'H', 'D', 'T', 'R', 'C', '1'};
+const char kBinaryMagicV2[8] = {'S', 'C', 'H', 'D', 'T', 'R', 'C', '2'};
+const char kBinaryMagicV3[8] = {'S', 'C', 'H', 'D', 'T', 'R', 'C', '3'};
+const size_t kFieldsPerProcess = 5;
+const size_t kRecordSizeV1 = kFieldsPerProcess * 4;
+const size_t kRecordSizeV2 = 4 * 8 + 4;   // Four int64 times, int32 priority
+const size_t kRecordSizeV3 = kRecordSizeV2 + 4;   // Then int32 threads
+const size_t kRecordsPerChunk = 1 << 16;
+
+void put_u64(unsigned char* out, uint64_t v) {
+    for (int i = 0; i < 8; i++) out[i] = (unsigned char)(v >> (8 * i));
+}
+
+uint64_t get_u64(const unsigned char* in) {
+    uint64_t v = 0;
+    for (int i = 0; i < 8; i++) v |= (uint64_t)in[i] << (8 * i);
+    return v;
+}
+
+void put_i32(unsigned char* out, int32_t v) {
+    uint32_t u = (uint32_t)v;
+    for (int i = 0; i < 4; i++) out[i] = (unsigned char)(u >> (8 * i));
+}
+
+int32_t get_i32(const unsigned char* in) {
+    uint32_t u = 0;
+    for (int i = 0; i < 4; i++) u |= (uint32_t)in[i] << (8 * i);
+    return (int32_t)u;
+}
+
+bool fits_i32(SimTime t) {
+    return t.ticks() >= INT32_MIN && t.ticks() <= INT32_MAX;
+}
+
+size_t record_size_of(int version) {
+    return version == 1 ? kRecordSizeV1 : version == 2 ? kRecordSizeV2 : kRecordSizeV3;
+}
+
+// One process in any of the record layouts
+Process read_record(const unsigned char* r, int version, uint64_t number) {
+    std::string pid = "P" + std::to_string(number);
+    if (version == 1) return Process(pid, SimTime(get_i32(r)), SimTime(get_i32(r + 4)), SimTime(get_i32(r + 8)),
+                                       SimTime(get_i32(r + 12)), get_i32(r + 16));
+    Process p(pid, SimTime((int64_t)get_u64(r)), SimTime((int64_t)get_u64(r + 8)), SimTime((int64_t)get_u64(r + 16)),
+              SimTime((int64_t)get_u64(r + 24)),
+              get_i32(r + 32));
+    if (version == 3) p.threads = std::max(get_i32(r + 36), 1);
+    return p;
+}
+
+void write_record(unsigned char* r, const Process& p, int version) {
+    if (version == 1) {
+        put_i32(r, (int32_t)p.arrival_time.ticks());
+        put_i32(r + 4, (int32_t)p.cpu_burst_time1.ticks());
+        put_i32(r + 8, (int32_t)p.io_time.ticks());
+        put_i32(r + 12, (int32_t)p.cpu_burst_time2.ticks());
+        put_i32(r + 16, p.priority);
+        return;
+    }
+    put_u64(r, (uint64_t)p.arrival_time.ticks());
+    put_u64(r + 8, (uint64_t)p.cpu_burst_time1.ticks());
+    put_u64(r + 16, (uint64_t)p.io_time.ticks());
+    put_u64(r + 24, (uint64_t)p.cpu_burst_time2.ticks());
+    put_i32(r + 32, p.priority);
+    if (version == 3) put_i32(r + 36, p.threads);
+}
+
+// Negative times would make the tick-stepping schedulers loop forever
+bool has_negative_time(const Process& p) {
+    const SimTime zero(0);
+    return p.arrival_time < zero || p.cpu_burst_time1 < zero || p.io_time < zero || p.cpu_burst_time2 < zero;
+}
+
+bool load_binary(std::ifstream& file, int version, std::vector<Process>& processes, std::string& error) {
+    unsigned char count_bytes[8];
+    if (!file.read((char*)count_bytes, sizeof(count_bytes))) {
+        error = "truncated header";
+        return false;
+    }
+    uint64_t count = get_u64(count_bytes);
+
+    // The count is only trusted as far as the file backs it up
+    const size_t record_size = record_size_of(version);
+    std::streampos records_start = file.tellg();
+    file.seekg(0, std::ios::end);
+    uint64_t available = (uint64_t)(file.tellg() - records_start) / record_size;
+    file.seekg(records_start);
+    if (count > available) {
+        error = "header claims " + std::to_string(count) + " processes, file holds " + std::to_string(available);
+        return false;
+    }
+
+    processes.clear();
+    processes.reserve(count);
+
+    std::vector<unsigned char> chunk(kRecordsPerChunk * record_size);
+    uint64_t loaded = 0;
+    while (loaded < count) {
+        size_t n = (size_t)std::min<uint64_t>(kRecordsPerChunk, count - loaded);
+        if (!file.read((char*)chunk.data(), (std::streamsize)(n * record_size))) {
+            error = "truncated after " + std::to_string(loaded) + " of " + std::to_string(count) + " processes";
+            return false;
+        }
+        for (size_t i = 0; i < n; i++) {
+            processes.push_back(read_record(chunk.data() + i * record_size, version, loaded + i + 1));
+            if (has_negative_time(processes.back())) {
+                error = "process " + std::to_string(loaded + i + 1) + " has a negative time";
+                return false;
+            }
+        }
+        loaded += n;
+    }
+    return true;
+}
+
+// Blank lines are skipped; any other line must hold five numbers and an
+// optional thread count, with no negative time
+bool load_text(std::ifstream& file, const std::string& filename, std::vector<Process>& processes,
+               std::string& error) {
+    processes.clear();
+    int id = 1;
+    int number = 0;
+    std::string line;
+    while (std::getline(file, line)) {
+        number++;
+        if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+        std::istringstream fields(line);
+        SimTime arrival_time, cpu_burst1, io_time, cpu_burst2;
+        int priority, threads = 1;
+        bool parsed = (bool)(fields >> arrival_time >> cpu_burst1 >> io_time >> cpu_burst2 >> priority);
+        if (parsed && !(fields >> std::ws).eof()) parsed = (fields >> threads) && (fields >> std::ws).eof();
+        if (!parsed) {
+            error = filename + ":" + std::to_string(number) + ": expected \"arrival cpu1 io cpu2 priority [threads]\"";
+            return false;
+        }
+        processes.emplace_back("P" + std::to_string(id), arrival_time, cpu_burst1, io_time, cpu_burst2, priority);
+        processes.back().threads = std::max(threads, 1);
+        if (has_negative_time(processes.back())) {
+            error = filename + ":" + std::to_string(number) + ": negative time";
+            return false;
+        }
+        id++;
+    }
+    return true;
+}
+
+}  // namespace
+
+bool load_workload(const std::string& filename, std::vector<Process>& processes, std::string& error) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) {
+        error = "cannot open " + filename;
+        return false;
+    }
+
+    char magic[sizeof(kBinaryMagic)] = {0};
+    file.read(magic, sizeof(magic));
+    int version = std::memcmp(magic, kBinaryMagic, sizeof(magic)) == 0     ? 1
+                  : std::memcmp(magic, kBinaryMagicV2, sizeof(magic)) == 0 ? 2
+                  : std::memcmp(magic, kBinaryMagicV3, sizeof(magic)) == 0 ? 3
+                                                                            : 0;
+    if (file.gcount() == (std::streamsize)sizeof(magic) && version != 0) {
+        if (!load_binary(file, version, processes, error)) {
+            error = filename + ": " + error;
+            return false;
+        }
+        return true;
+    }
+
+    file.clear();
+    file.seekg(0);
+    return load_text(file, filename, processes, error);
+}
+
+bool save_workload_text(const std::string& filename, const std::vector<Process>& processes) {
+    std::ofstream file(filename);
+    if (!file) return false;
+
+    for (const auto& p : processes) {
+        file << p.arrival_time << " " << p.cpu_burst_time1 << " "
+             << p.io_time << " " << p.cpu_burst_time2 << " " << p.priority;
+        if (p.threads != 1) file << " " << p.threads;
+        file << "\n";
+    }
+    return (bool)file;
+}
+
+bool save_workload_binary(const std::string& filename, const std::vector<Process>& processes) {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file) return false;
+
+    bool wide = std::any_of(processes.begin(), processes.end(), [](const Process& p) {
+        return !fits_i32(p.arrival_time) || !fits_i32(p.cpu_burst_time1) || !fits_i32(p.io_time) ||
+               !fits_i32(p.cpu_burst_time2);
+    });
+    bool threaded = std::any_of(processes.begin(), processes.end(), [](const Process& p) { return p.threads != 1; });
+    int version = threaded ? 3 : wide ? 2 : 1;
+
+    unsigned char header[16];
+    std::memcpy(header, version == 3 ? kBinaryMagicV3 : version == 2 ? kBinaryMagicV2 : kBinaryMagic,
+                sizeof(kBinaryMagic));
+    put_u64(header + 8, processes.size());
+    file.write((const char*)header, sizeof(header));
+
+    const size_t record_size = record_size_of(version);
+    std::vector<unsigned char> chunk;
+    chunk.reserve(kRecordsPerChunk * record_size);
+    for (size_t i = 0; i < processes.size(); i++) {
+        unsigned char r[kRecordSizeV3];
+        write_record(r, processes[i], version);
+        chunk.insert(chunk.end(), r, r + record_size);
+
+        if (chunk.size() == kRecordsPerChunk * record_size || i + 1 == processes.size()) {
+            file.write((const char*)chunk.data(), (std::streamsize)chunk.size());
+            chunk.clear();
+        }
+    }
+    return (bool)file;
+}
+
+std::vector<Process> generate_random_workload(long long count, unsigned seed, int arrival_span) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> arrival(0, std::max(arrival_span, 1) - 1);
+    std::uniform_int_distribution<int> burst(1, 10);
+    std::uniform_int_distribution<int> io(0, 9);
+    std::uniform_int_distribution<int> prio(1, 10);
+
+    std::vector<Process> processes;
+    processes.reserve(count);
+    for (long long i = 1; i <= count; i++) {
+        int at = arrival(rng);
+        int cpu1 = burst(rng);
+        int io_time = io(rng);
+        int cpu2 = io(rng);
+        processes.emplace_back("P" + std::to_string(i), SimTime(at), SimTime(cpu1), SimTime(io_time), SimTime(cpu2),
+                               prio(rng));
+    }
+    return processes;
+}
+
+void assign_random_threads(std::vector<Process>& processes, int max_threads, unsigned seed) {
+    // Its own generator, so the times match the single-threaded workload
+    std::mt19937 rng(seed ^ 0x7468726Du);
+    std::uniform_int_distribution<int> threads(1, std::max(max_threads, 1));
+    for (auto& p : processes) p.threads = threads(rng);
+}
@@ -0,0 +1,39 @@
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <string>
+#include <vector>
+#include "Process.h"
+
+// Process lists on disk come in two formats:
+//  - text: one "arrival cpu1 io cpu2 priority [threads]" line per process,
+//    as written by the simulator's "Save Process Data to File"; threads
+//    defaults to 1
+//  - binary: the 8-byte magic "SCHDTRC1", a little-endian uint64 count, then
+//    five little-endian int32 fields per process in the same order
+//  - binary v2: magic "SCHDTRC2", the count, then per process the four
+//    times as little-endian int64 and the priority as int32
+//  - binary v3: as v2, followed by the thread count as int32
+// save_workload_binary() writes v1 when every time fits in 32 bits, so
+// existing readers keep working, v2 otherwise, and v3 only when some
+// process has more than one thread.
+// Processes are named P1..Pn in file order.
+
+// Reads either format (detected from the magic). Returns false and fills
+// error (naming the line, for text) if the file cannot be read or is
+// malformed: a line that is neither blank nor a process, a negative time,
+// or a binary count the file is too short for.
+bool load_workload(const std::string& filename, std::vector<Process>& processes, std::string& error);
+
+bool save_workload_text(const std::string& filename, const std::vector<Process>& processes);
+bool save_workload_binary(const std::string& filename, const std::vector<Process>& processes);
+
+// Same value ranges as the simulator's random generator; arrivals are drawn
+// from [0, arrival_span)
+std::vector<Process> generate_random_workload(long long count, unsigned seed, int arrival_span = 20);
+
+// Draws each process's thread count from [1, max_threads]. Leaves the
+// times alone, so single- and multi-threaded runs of a seed are comparable.
+void assign_random_threads(std::vector<Process>& processes, int max_threads, unsigned seed);
+
+#endif
@@ -10,12 +10,12 @@
 #include "GranttAnalysis.h"
 
 // Include all scheduler implementations
-#include "fcfs.cpp"
-#include "sjf.cpp"
-#include "rr.cpp"
-#include "mlfq.cpp"
-#include "fcfsPreemp.cpp"
-#include "priority.cpp"
+#include "fcfs.h"
+#include "sjf.h"
+#include "rr.h"
+#include "mlfq.h"
+#include "fcfsPreemp.h"
+#include "priority.h"
 
 using namespace std;
 
@@ -56,7 +56,8 @@ vector<Process> getProcessData() {
     
     for (int i = 0; i < n; i++) {
         string pid;
-        int arrival_time, cpu_burst1, io_time, cpu_burst2, priority;
+        SimTime arrival_time, cpu_burst1, io_time, cpu_burst2;
+        int priority;
         
         cout << "\nProcess " << (i + 1) << ":" << endl;
         cout << "Process ID: ";
@@ -262,9 +263,9 @@ int main() {
     
     // Default sample processes
     processes = {
-        Process("P1", 0, 4, 3, 5, 3),
-        Process("P2", 2, 3, 2, 4, 1),
-        Process("P3", 5, 2, 4, 3, 2)
+        Process("P1", SimTime(0), SimTime(4), SimTime(3), SimTime(5), 3),
+        Process("P2", SimTime(2), SimTime(3), SimTime(2), SimTime(4), 1),
+        Process("P3", SimTime(5), SimTime(2), SimTime(4), SimTime(3), 2)
     };
     
     while (true) {
@@ -0,0 +1,22 @@
+#ifndef FCFS_H
+#define FCFS_H
+
+#include <string>
+#include <vector>
+#include "Process.h"
+#include "ProcessGrantInfo.h"
+
+class FCFS {
+private:
+    std::vector<Process> processes;
+    std::vector<ProcessGrantInfo> grantt_chart;
+
+public:
+    FCFS(std::vector<Process> procs) : processes(procs) {}
+
+    std::vector<ProcessGrantInfo> cpu_process();
+
+    void print_chart();
+};
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef FCFS_PREEMP_H
+#define FCFS_PREEMP_H
+
+#include <string>
+#include <vector>
+#include "Process.h"
+#include "ProcessGrantInfo.h"
+
+class FCFSPreemp {
+public:
+    std::vector<Process> processes;
+    std::vector<ProcessGrantInfo> grantt_chart;
+    SimTime current_cpu_time{};
+    std::string ClassName = "FCFSPreemp";
+
+    FCFSPreemp(const std::vector<Process>& procs) : processes(procs) {}
+
+    std::vector<ProcessGrantInfo> cpu_process();
+};
+
+#endif
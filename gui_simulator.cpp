@@ -9,13 +9,8 @@
 
 #include "Process.h"
 #include "ProcessGrantInfo.h"
-
-// Include all scheduler implementations
-#include "fcfs.cpp"  // Assuming this exists
-#include "sjf.cpp"
-#include "rr.cpp"
-#include "mlfq.cpp"
-#include "fcfsPreemp.cpp"
+#include "SchedulerRegistry.h"
+#include "IncrementalSimulation.h"
 
 // Simple GUI implementation using Windows API
 #ifdef _WIN32
@@ -41,6 +36,7 @@ HWND g_hwndLevelsList = NULL;
 
 std::vector<Process> g_processes;
 std::vector<ProcessGrantInfo> g_ganttChart;
+IncrementalSimulation g_simulation;   // Last run; re-running after an edit resumes from a checkpoint
 
 // Forward declarations
 LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
@@ -181,12 +177,14 @@ void CreateControls(HWND hwnd) {
         350, 50, 150, 200,
         hwnd, NULL, NULL, NULL
     );
-    ComboBox_AddString(g_hwndAlgorithmCombo, "Round Robin");
-    ComboBox_AddString(g_hwndAlgorithmCombo, "Multi Level");
-    ComboBox_AddString(g_hwndAlgorithmCombo, "SJF");
-    ComboBox_AddString(g_hwndAlgorithmCombo, "FCFS");
-    ComboBox_AddString(g_hwndAlgorithmCombo, "FCFS Preemptive");
-    ComboBox_SetCurSel(g_hwndAlgorithmCombo, 0);
+    // One entry per registered algorithm, in registry order
+    const auto& algorithms = SchedulerRegistry::instance().all();
+    int selected = 0;
+    for (size_t i = 0; i < algorithms.size(); i++) {
+        ComboBox_AddString(g_hwndAlgorithmCombo, algorithms[i].title.c_str());
+        if (algorithms[i].name == "rr") selected = (int)i;
+    }
+    ComboBox_SetCurSel(g_hwndAlgorithmCombo, selected);
 
     // Simulation speed label
     CreateWindow(
@@ -230,7 +228,7 @@ void CreateControls(HWND hwnd) {
 
     // Quantum edit
     g_hwndQuantumEdit = CreateWindow(
-        "EDIT", "1",
+        "EDIT", "",
         WS_CHILD | WS_VISIBLE | WS_BORDER | ES_NUMBER,
         410, 150, 50, 20,
         hwnd, NULL, NULL, NULL
@@ -401,50 +399,35 @@ void RunSimulation() {
     }
 
     // Get selected algorithm
+    const auto& algorithms = SchedulerRegistry::instance().all();
     int algorithm = ComboBox_GetCurSel(g_hwndAlgorithmCombo);
+    if (algorithm < 0 || algorithm >= (int)algorithms.size()) {
+        MessageBox(g_hwndMain, "Select an algorithm", "Error", MB_OK | MB_ICONERROR);
+        return;
+    }
+    const SchedulerInfo& info = algorithms[algorithm];
     
-    // Get quantum value for RR and MLFQ
+    // Quantum for algorithms that take one. A typed value (0 included: no
+    // time slicing for smp and gang) goes to any of them and the registry
+    // checks its range; a blank box keeps each algorithm's own default
     char quantumStr[32];
     GetWindowText(g_hwndQuantumEdit, quantumStr, sizeof(quantumStr));
-    int quantum = atoi(quantumStr);
-    if (quantum <= 0) quantum = 1;
-
-    // Run the selected algorithm
-    switch (algorithm) {
-        case 0: // Round Robin
-            {
-                RoundRobin rr(g_processes);
-                g_ganttChart = rr.cpu_process(quantum);
-            }
-            break;
-        case 1: // Multi Level
-            {
-                MLFQ mlfq(g_processes);
-                g_ganttChart = mlfq.cpu_process();
-            }
-            break;
-        case 2: // SJF
-            {
-                SJF sjf(g_processes);
-                g_ganttChart = sjf.cpu_process();
-            }
-            break;
-        case 3: // FCFS
-            {
-                // Assuming FCFS class exists
-                // FCFS fcfs(g_processes);
-                // g_ganttChart = fcfs.cpu_process();
-                MessageBox(g_hwndMain, "FCFS not implemented yet", "Info", MB_OK | MB_ICONINFORMATION);
-                return;
-            }
-            break;
-        case 4: // FCFS Preemptive
-            {
-                FCFSPreemp fcfsPreemp(g_processes);
-                g_ganttChart = fcfsPreemp.cpu_process();
-            }
-            break;
+    bool quantumGiven = quantumStr[0] != '\0';
+
+    SchedulerParams params;
+    if (quantumGiven && info.find_param("quantum") != nullptr) params.set("quantum", atoi(quantumStr));
+
+    // Same algorithm and settings as last time: only the edits need re-running
+    std::string error;
+    bool same_run = g_simulation.started() && g_simulation.algorithm_name() == info.name &&
+                    g_simulation.algorithm_params().all() == params.all();
+    bool ran = same_run ? g_simulation.update(g_processes, error)
+                        : g_simulation.start(info.name, params, g_processes, error);
+    if (!ran) {
+        MessageBox(g_hwndMain, error.c_str(), "Error", MB_OK | MB_ICONERROR);
+        return;
     }
+    g_ganttChart = g_simulation.records();
 
     // Display the Gantt chart in a new window
     DisplayGanttChart(g_ganttChart);
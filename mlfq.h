@@ -0,0 +1,26 @@
+#ifndef MLFQ_H
+#define MLFQ_H
+
+#include <string>
+#include <vector>
+#include "Process.h"
+#include "ProcessGrantInfo.h"
+
+class MLFQ {
+public:
+    std::vector<Process> processes;
+    std::vector<ProcessGrantInfo> grantt_chart;
+    SimTime current_cpu_time{};
+    std::string ClassName = "MLFQ";
+
+    MLFQ(const std::vector<Process>& procs) : processes(procs) {}
+
+    std::vector<ProcessGrantInfo> cpu_process();
+
+private:
+    void two_queue_with_diff_quantum(int first_time_quantum, int second_time_quantum);
+
+    void fcfs_queue();
+};
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef PRIORITY_H
+#define PRIORITY_H
+
+#include <vector>
+#include "DecisionLatency.h"
+#include "Process.h"
+#include "ProcessGrantInfo.h"
+
+class PriorityScheduler {
+private:
+    std::vector<Process> processes;
+    std::vector<ProcessGrantInfo> grantt_chart;
+    bool preemptive;
+    uint32_t decision_sample_every = 0;
+    DecisionLatency latency;
+
+public:
+    PriorityScheduler(std::vector<Process> procs, bool is_preemptive = false)
+        : processes(procs), preemptive(is_preemptive) {}
+
+    std::vector<ProcessGrantInfo> cpu_process();
+
+    // Times every `every`th pick of the highest-priority ready process
+    void set_decision_sampling(uint32_t every) { decision_sample_every = every; }
+    const DecisionLatency& decision_latency() const { return latency; }
+
+private:
+    std::vector<ProcessGrantInfo> non_preemptive_priority();
+   
+    std::vector<ProcessGrantInfo> preemptive_priority();
+};
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef RR_H
+#define RR_H
+
+#include <string>
+#include <vector>
+#include "Process.h"
+#include "ProcessGrantInfo.h"
+
+class RoundRobin {
+public:
+    std::vector<Process> processes;
+    std::vector<ProcessGrantInfo> grantt_chart;
+    SimTime current_cpu_time{};
+    std::string ClassName = "RoundRobin";
+
+    RoundRobin(const std::vector<Process>& procs) : processes(procs) {}
+
+    std::vector<ProcessGrantInfo> cpu_process(int time_quantum = 4);
+};
+
+#endif
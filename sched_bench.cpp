@@ -0,0 +1,318 @@
+// Scheduler benchmark: times every algorithm's cpu_process() across
+// workload sizes and prints the results as JSON.
+//
+//   sched_bench [--sizes 1000,10000,...] [--reps N] [--warmup N]
+//               [--algos fcfs,sjf,...] [--quantum Q] [--budget SECONDS]
+//               [--seed S] [--output FILE]
+//
+// Sizes whose predicted run time (extrapolated from the two previous sizes)
+// exceeds the per-repetition budget are reported as skipped, so quadratic
+// algorithms do not stall the whole run at 10M processes.
+//
+// peak_rss_kb is measured by one extra run in a freshly exec'd sched_bench
+// (the internal --rss-probe mode), which builds the same workload, runs the
+// algorithm once and reports its own high-water mark. A forked child would
+// inherit this process's pages, and its ru_maxrss this process's peak, so
+// earlier (larger) entries would leak into later ones.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "Process.h"
+#include "ProcessGrantInfo.h"
+#include "Workload.h"
+
+#include "SchedulerRegistry.h"
+#include "RunArena.h"
+
+namespace {
+
+struct BenchOptions {
+    std::vector<long long> sizes = {1000, 10000, 100000, 1000000, 10000000};
+    std::vector<std::string> algos;
+    int reps = 5;
+    int warmup = 1;
+    int quantum = 4;
+    double budget_sec = 30.0;
+    unsigned seed = 42;
+    std::string output;
+    bool rss_probe = false;   // --rss-probe: one run, print its peak RSS (see peak_rss_kb)
+};
+
+struct Algorithm {
+    std::string name;
+    std::function<size_t(const std::vector<Process>&, int)> run;   // returns chart size
+};
+
+// Only the record count is kept, so result copies stay out of the timing
+class CountingSink : public ScheduleSink {
+public:
+    size_t records = 0;
+    void chart(const std::vector<ProcessGrantInfo>& r) override { records = r.size(); }
+};
+
+// Every registered scheduler; --quantum goes to those that need one (not
+// to those whose default of 0 turns time slicing off, as in sched_cli)
+std::vector<Algorithm> all_algorithms() {
+    std::vector<Algorithm> algorithms;
+    for (const auto& info : SchedulerRegistry::instance().all()) {
+        std::string name = info.name;
+        bool takes_quantum = info.wants_default_quantum();
+        algorithms.push_back({name, [name, takes_quantum](const std::vector<Process>& p, int q) {
+            SchedulerParams params;
+            if (takes_quantum) params.set("quantum", q);
+            CountingSink sink;
+            std::string error;
+            if (!SchedulerRegistry::instance().run(name, p, params, sink, error)) std::cerr << error << "\n";
+            return sink.records;
+        }});
+    }
+    return algorithms;
+}
+
+// Arrivals spread in proportion to the workload keep the ready queue realistic
+std::vector<Process> bench_workload(long long n, unsigned seed) {
+    int arrival_span = (int)std::min<long long>(n * 5, 1000000000LL);
+    return generate_random_workload(n, seed, arrival_span);
+}
+
+// This process's peak resident set: VmHWM where /proc has it, otherwise
+// the rusage high-water mark
+long own_peak_rss_kb() {
+#ifndef _WIN32
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmHWM:") == 0) return std::atol(line.c_str() + 6);
+    }
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) return usage.ru_maxrss;
+#endif
+    return 0;
+}
+
+// Peak RSS of one run of `algo` on n processes, in a new sched_bench
+// (`self`) started with --rss-probe; 0 where that is not possible or the
+// probe fails
+long peak_rss_kb(const char* self, const std::string& algo, long long n, const BenchOptions& opts) {
+#ifndef _WIN32
+    int fds[2];
+    if (pipe(fds) != 0) return 0;
+    std::vector<std::string> args = {self,     "--rss-probe", "--algos", algo, "--sizes", std::to_string(n),
+                                     "--seed", std::to_string(opts.seed), "--quantum", std::to_string(opts.quantum)};
+    std::vector<char*> argv;
+    for (auto& a : args) argv.push_back(&a[0]);
+    argv.push_back(nullptr);
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        dup2(fds[1], STDOUT_FILENO);
+        close(fds[0]);
+        close(fds[1]);
+        execvp(self, argv.data());
+        _exit(127);
+    }
+    close(fds[1]);
+    std::string reply;
+    char buffer[64];
+    ssize_t got;
+    while (pid > 0 && (got = read(fds[0], buffer, sizeof(buffer))) > 0) reply.append(buffer, (size_t)got);
+    close(fds[0]);
+    int status = 0;
+    if (pid > 0 && waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0) {
+        return std::atol(reply.c_str());
+    }
+#endif
+    (void)self;
+    (void)algo;
+    (void)n;
+    (void)opts;
+    return 0;
+}
+
+double percentile(std::vector<double> sorted, double p) {
+    if (sorted.empty()) return 0;
+    size_t rank = (size_t)std::ceil(p * sorted.size());
+    return sorted[std::min(sorted.size(), std::max<size_t>(rank, 1)) - 1];
+}
+
+std::vector<std::string> split(const std::string& text) {
+    std::vector<std::string> parts;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) parts.push_back(item);
+    }
+    return parts;
+}
+
+void usage() {
+    std::cerr << "Usage: sched_bench [--sizes N,N,...] [--reps N] [--warmup N] [--algos A,B,...]\n"
+              << "                   [--quantum Q] [--budget SECONDS] [--seed S] [--output FILE]\n";
+}
+
+bool parse_args(int argc, char** argv, BenchOptions& opts) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            usage();
+            std::exit(0);
+        }
+        if (arg == "--rss-probe") {
+            opts.rss_probe = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << "\n";
+            return false;
+        }
+        std::string value = argv[++i];
+        if (arg == "--sizes") {
+            opts.sizes.clear();
+            for (const auto& s : split(value)) opts.sizes.push_back(std::atoll(s.c_str()));
+        } else if (arg == "--algos") {
+            opts.algos = split(value);
+        } else if (arg == "--reps") {
+            opts.reps = std::max(1, std::atoi(value.c_str()));
+        } else if (arg == "--warmup") {
+            opts.warmup = std::max(0, std::atoi(value.c_str()));
+        } else if (arg == "--quantum") {
+            opts.quantum = std::max(1, std::atoi(value.c_str()));
+        } else if (arg == "--budget") {
+            opts.budget_sec = std::atof(value.c_str());
+        } else if (arg == "--seed") {
+            opts.seed = (unsigned)std::strtoul(value.c_str(), nullptr, 10);
+        } else if (arg == "--output") {
+            opts.output = value;
+        } else {
+            std::cerr << "Unknown option " << arg << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    BenchOptions opts;
+    if (!parse_args(argc, argv, opts)) {
+        usage();
+        return 1;
+    }
+
+    std::vector<Algorithm> algorithms;
+    for (auto& algo : all_algorithms()) {
+        if (opts.algos.empty() || std::find(opts.algos.begin(), opts.algos.end(), algo.name) != opts.algos.end()) {
+            algorithms.push_back(algo);
+        }
+    }
+    if (algorithms.empty()) {
+        std::cerr << "No matching algorithms\n";
+        return 1;
+    }
+    if (opts.rss_probe) {
+        if (algorithms.size() != 1 || opts.sizes.size() != 1) return 1;
+        std::vector<Process> workload = bench_workload(opts.sizes[0], opts.seed);
+        algorithms[0].run(workload, opts.quantum);
+        std::cout << own_peak_rss_kb() << "\n";
+        return 0;
+    }
+
+    std::ostringstream json;
+    json << "{\n  \"benchmark\": \"sched_bench\",\n  \"seed\": " << opts.seed
+         << ",\n  \"repetitions\": " << opts.reps << ",\n  \"warmup\": " << opts.warmup
+         << ",\n  \"quantum\": " << opts.quantum << ",\n  \"results\": [";
+
+    bool first_result = true;
+    for (const auto& algo : algorithms) {
+        long long prev_n = 0, last_n = 0;
+        double prev_sec = 0, last_sec = 0;
+
+        for (long long n : opts.sizes) {
+            json << (first_result ? "\n" : ",\n");
+            first_result = false;
+            json << "    {\"algorithm\": \"" << algo.name << "\", \"processes\": " << n;
+
+            // Extrapolate with the growth rate seen so far (quadratic until known)
+            if (last_n > 0) {
+                double exponent = 2.0;
+                if (prev_n > 0 && prev_sec > 0 && last_sec > prev_sec) {
+                    exponent = std::log(last_sec / prev_sec) / std::log((double)last_n / prev_n);
+                }
+                double predicted = last_sec * std::pow((double)n / last_n, std::max(exponent, 1.0));
+                if (predicted > opts.budget_sec) {
+                    std::cerr << algo.name << " n=" << n << ": skipped (predicted " << predicted << " s)\n";
+                    json << ", \"skipped\": \"predicted " << predicted << " s exceeds budget\"}";
+                    continue;
+                }
+            }
+
+            std::vector<Process> workload = bench_workload(n, opts.seed);
+            long rss_kb = peak_rss_kb(argv[0], algo.name, n, opts);
+            size_t records = 0;
+            size_t arena_kb = 0;
+            std::vector<double> samples;
+            std::thread runner([&]() {
+                for (int w = 0; w < opts.warmup; w++) records = algo.run(workload, opts.quantum);
+                for (int r = 0; r < opts.reps; r++) {
+                    auto start = std::chrono::steady_clock::now();
+                    records = algo.run(workload, opts.quantum);
+                    auto end = std::chrono::steady_clock::now();
+                    samples.push_back(std::chrono::duration<double>(end - start).count());
+                    if (samples.back() > opts.budget_sec) break;
+                }
+                arena_kb = RunArena::local().capacity() / 1024;
+            });
+            runner.join();
+            std::sort(samples.begin(), samples.end());
+
+            double median = percentile(samples, 0.5);
+            double p95 = percentile(samples, 0.95);
+            std::cerr << algo.name << " n=" << n << ": median " << median * 1000 << " ms\n";
+
+            json << ", \"repetitions\": " << samples.size()
+                 << ", \"median_ms\": " << median * 1000
+                 << ", \"p95_ms\": " << p95 * 1000
+                 << ", \"min_ms\": " << samples.front() * 1000
+                 << ", \"processes_per_sec\": " << (median > 0 ? n / median : 0)
+                 << ", \"chart_records\": " << records
+                 << ", \"peak_rss_kb\": " << rss_kb
+                 << ", \"arena_kb\": " << arena_kb << "}";
+
+            prev_n = last_n;
+            prev_sec = last_sec;
+            last_n = n;
+            last_sec = median;
+        }
+    }
+    json << "\n  ]\n}\n";
+
+    if (opts.output.empty()) {
+        std::cout << json.str();
+    } else {
+        std::ofstream file(opts.output);
+        if (!file) {
+            std::cerr << "Error opening " << opts.output << " for writing\n";
+            return 1;
+        }
+        file << json.str();
+    }
+    return 0;
+}
@@ -0,0 +1,837 @@
+// Non-interactive scheduler runner for scripts and pipelines.
+//
+//   sched_cli --algo rr --quantum 8 --input trace.bin --metrics json
+//   sched_cli --algo all --random 100000 --seed 7 --threads 8 --metrics csv
+//   sched_cli --algo policy-rr,policy-sjf --random 1000 --replications 100 --threads 8
+//   sched_cli --algo policy-mlfq --param quantum=4,levels=3 --input trace.txt
+//   sched_cli --algo policy-rr,policy-sjf --prefix policy-fcfs --fork-at 500 --random 100000
+//   sched_cli --algo lottery,stride --random 10000 --shares shares.csv
+//   sched_cli --list
+//
+// Runs each requested algorithm over the workload without prompting and
+// writes one structured record per algorithm. Exit status is 0 on success,
+// 1 for bad arguments and 2 when the workload or an output cannot be used.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Process.h"
+#include "ProcessGrantInfo.h"
+#include "GranttAnalysis.h"
+#include "Segment.h"
+#include "GanttRenderer.h"
+#include "ChromeTraceWriter.h"
+#include "Workload.h"
+#include "SchedulerRegistry.h"
+#include "ShareReport.h"
+#include "Instrumentation.h"
+#include "Replication.h"
+#include "ResultStream.h"
+
+namespace {
+
+struct CliOptions {
+    std::vector<std::string> algos;
+    int quantum = 4;
+    bool quantum_given = false;
+    std::string params;   // --param name=value,...
+    std::string input;
+    long long random_count = 0;
+    unsigned seed = 1;
+    int max_threads = 1;   // --max-threads: random thread counts for the multi-CPU algorithms
+    std::string cpu_limits;   // --cpu-limits: affinity and bandwidth groups for the multi-CPU algorithms
+    std::string metrics = "json";
+    std::string output;
+    std::string gantt;
+    std::string trace;
+    std::string shares;
+    std::string counters;
+    std::string profile;
+    std::string latency;
+    int latency_every = 1;
+    std::string histogram;
+    int histogram_buckets = 20;
+    std::string save_workload;
+    std::string raw;   // --raw: one record per run, streamed as runs finish
+    ResultFormat raw_format = ResultFormat::Csv;
+    int threads = 1;
+    long long replications = 0;   // --replications: independent seeded workloads
+    SimTime fork_at = SimTime(-1);   // --fork-at: run the prefix to here, then fork
+    TimeUnit time_unit = TimeUnit::Milliseconds;
+    std::string prefix = "policy-fcfs";
+};
+
+struct RunResult {
+    const SchedulerInfo* algorithm = nullptr;
+    double wall_ms = 0;
+    ScheduleCollector output;
+    AnalysisSummary summary;
+    TurnaroundHistogram turnaround;   // Only with --histogram
+    std::string error;
+};
+
+// The registry's parameters for one algorithm: --quantum feeds any
+// algorithm with a "quantum" parameter, --param overrides by name. The
+// default quantum only goes to algorithms that need one: those whose own
+// default of 0 means no time slicing (smp, gang) keep it unless --quantum
+// is given.
+SchedulerParams params_for(const SchedulerInfo& algo, const CliOptions& opts, const SchedulerParams& explicit_params) {
+    SchedulerParams params;
+    bool given = opts.quantum_given && algo.find_param("quantum") != nullptr;
+    if (given || algo.wants_default_quantum()) params.set("quantum", opts.quantum);
+    for (const auto& kv : explicit_params.all()) {
+        if (algo.find_param(kv.first) != nullptr) params.set(kv.first, kv.second);
+    }
+    return params;
+}
+
+void list_algorithms(std::ostream& out) {
+    for (const auto& a : SchedulerRegistry::instance().all()) {
+        out << a.name << "\t" << a.title << "\n";
+        for (const auto& p : a.params) {
+            out << "    " << p.name << "=" << p.default_value << "  [" << p.min_value << ", " << p.max_value << "]  "
+                << p.description << "\n";
+        }
+    }
+}
+
+void usage(std::ostream& out) {
+    out << "Usage: sched_cli --algo NAME[,NAME...] (--input FILE | --random N) [options]\n"
+        << "\n"
+        << "  --algo NAMES        comma-separated list, or \"all\"\n"
+        << "  --quantum Q         time quantum for algorithms that take one (default 4;\n"
+        << "                      smp and gang run bursts whole unless it is given)\n"
+        << "  --param K=V[,K=V]   set algorithm parameters by name (see --list)\n"
+        << "  --list              list algorithms and their parameters, then exit\n"
+        << "  --input FILE        workload, text or binary (see Workload.h)\n"
+        << "  --random N          generate N random processes instead of reading a file\n"
+        << "  --seed S            seed for --random (default 1)\n"
+        << "  --max-threads T     give --random processes 1..T threads each (for smp, gang)\n"
+        << "  --cpu-limits FILE   CPU affinity and quota groups for smp and gang (see\n"
+        << "                      CpuConstraints.h)\n"
+        << "  --metrics FORMAT    json (default), csv or text\n"
+        << "  --output FILE       write metrics to FILE instead of stdout\n"
+        << "  --gantt FILE        write ASCII Gantt charts to FILE (\"-\" for stderr)\n"
+        << "  --trace FILE        write a Chrome trace; with several algorithms the\n"
+        << "                      algorithm name is inserted before the extension\n"
+        << "  --shares FILE       write proportional-share accuracy (CSV) per ticket class\n"
+        << "  --counters FILE     write per-process scheduling counters (CSV); policy engine only\n"
+        << "  --latency FILE      write scheduling-decision latency (CSV) per algorithm:\n"
+        << "                      queue insert and pick, and pick by ready-queue length\n"
+        << "  --latency-every N   time every Nth decision (default 1)\n"
+        << "  --histogram FILE    write the turnaround-time distribution (CSV) per algorithm\n"
+        << "  --histogram-buckets N\n"
+        << "                      buckets per algorithm for --histogram (default 20)\n"
+        << "  --profile FILE      write time and calls per simulator stage (\"-\" for stderr);\n"
+        << "                      needs a build with -DSCHED_INSTRUMENT=ON\n"
+        << "  --save-workload F   also write the workload as a binary trace\n"
+        << "  --raw FILE          stream one record per run (and per replication) to FILE\n"
+        << "                      as runs finish; see ResultStream.h\n"
+        << "  --raw-format F      csv (default), json or binary\n"
+        << "  --time-unit U       what one tick is: ns, us or ms (default ms); scales\n"
+        << "                      throughput and trace timestamps\n"
+        << "  --threads N         run up to N algorithms (or replications) concurrently\n"
+        << "  --replications K    run K independent --random workloads (seeds derived from\n"
+        << "                      --seed) and report means with 95% confidence intervals\n"
+        << "  --fork-at T         run --prefix up to time T, then continue the same\n"
+        << "                      snapshot under each --algo (policy-* algorithms only)\n"
+        << "  --prefix NAME       algorithm that runs before --fork-at (default policy-fcfs)\n"
+        << "\nAlgorithms:";
+    for (const auto& a : SchedulerRegistry::instance().all()) out << " " << a.name;
+    out << "\n";
+}
+
+std::vector<std::string> split(const std::string& text) {
+    std::vector<std::string> parts;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) parts.push_back(item);
+    }
+    return parts;
+}
+
+bool parse_args(int argc, char** argv, CliOptions& opts) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            usage(std::cout);
+            std::exit(0);
+        }
+        if (arg == "--list") {
+            list_algorithms(std::cout);
+            std::exit(0);
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "sched_cli: missing value for " << arg << "\n";
+            return false;
+        }
+        std::string value = argv[++i];
+        if (arg == "--algo") {
+            opts.algos = split(value);
+        } else if (arg == "--quantum") {
+            opts.quantum = std::atoi(value.c_str());
+            opts.quantum_given = true;
+        } else if (arg == "--param") {
+            opts.params += (opts.params.empty() ? "" : ",") + value;
+        } else if (arg == "--input") {
+            opts.input = value;
+        } else if (arg == "--random") {
+            opts.random_count = std::atoll(value.c_str());
+        } else if (arg == "--seed") {
+            opts.seed = (unsigned)std::strtoul(value.c_str(), nullptr, 10);
+        } else if (arg == "--metrics") {
+            opts.metrics = value;
+        } else if (arg == "--output") {
+            opts.output = value;
+        } else if (arg == "--gantt") {
+            opts.gantt = value;
+        } else if (arg == "--trace") {
+            opts.trace = value;
+        } else if (arg == "--counters") {
+            opts.counters = value;
+        } else if (arg == "--latency") {
+            opts.latency = value;
+        } else if (arg == "--latency-every") {
+            opts.latency_every = std::atoi(value.c_str());
+        } else if (arg == "--histogram") {
+            opts.histogram = value;
+        } else if (arg == "--histogram-buckets") {
+            opts.histogram_buckets = std::atoi(value.c_str());
+        } else if (arg == "--profile") {
+            opts.profile = value;
+        } else if (arg == "--shares") {
+            opts.shares = value;
+        } else if (arg == "--save-workload") {
+            opts.save_workload = value;
+        } else if (arg == "--raw") {
+            opts.raw = value;
+        } else if (arg == "--raw-format") {
+            if (!parse_result_format(value, opts.raw_format)) {
+                std::cerr << "sched_cli: unknown raw format " << value << "\n";
+                return false;
+            }
+        } else if (arg == "--replications") {
+            opts.replications = std::atoll(value.c_str());
+        } else if (arg == "--max-threads") {
+            opts.max_threads = std::atoi(value.c_str());
+        } else if (arg == "--cpu-limits") {
+            opts.cpu_limits = value;
+        } else if (arg == "--threads") {
+            opts.threads = std::atoi(value.c_str());
+        } else if (arg == "--fork-at") {
+            opts.fork_at = SimTime(std::atoll(value.c_str()));
+        } else if (arg == "--time-unit") {
+            if (!parse_time_unit(value, opts.time_unit)) {
+                std::cerr << "sched_cli: unknown time unit " << value << "\n";
+                return false;
+            }
+        } else if (arg == "--prefix") {
+            opts.prefix = value;
+        } else {
+            std::cerr << "sched_cli: unknown option " << arg << "\n";
+            return false;
+        }
+    }
+
+    if (opts.algos.empty()) {
+        std::cerr << "sched_cli: --algo is required\n";
+        return false;
+    }
+    if (opts.input.empty() == (opts.random_count <= 0)) {
+        std::cerr << "sched_cli: give exactly one of --input or --random\n";
+        return false;
+    }
+    if (opts.metrics != "json" && opts.metrics != "csv" && opts.metrics != "text") {
+        std::cerr << "sched_cli: unknown metrics format " << opts.metrics << "\n";
+        return false;
+    }
+    if (opts.quantum <= 0 || opts.threads <= 0 || opts.latency_every <= 0 || opts.max_threads <= 0 ||
+        opts.histogram_buckets <= 0) {
+        std::cerr << "sched_cli: --quantum, --threads, --latency-every, --max-threads and --histogram-buckets must "
+                     "be positive\n";
+        return false;
+    }
+    if (opts.replications < 0 || (opts.replications > 0 && opts.random_count <= 0)) {
+        std::cerr << "sched_cli: --replications needs a positive count and --random\n";
+        return false;
+    }
+    if (opts.replications > 0 && (opts.fork_at >= SimTime(0) || !opts.gantt.empty() || !opts.trace.empty() ||
+                                  !opts.counters.empty() || !opts.shares.empty() || !opts.latency.empty() ||
+                                  !opts.histogram.empty() || !opts.save_workload.empty() || !opts.cpu_limits.empty())) {
+        std::cerr << "sched_cli: --replications only reports metrics\n";
+        return false;
+    }
+    return true;
+}
+
+std::string trace_filename(const std::string& base, const std::string& algo, bool several) {
+    if (!several) return base;
+    size_t dot = base.find_last_of('.');
+    size_t slash = base.find_last_of("/\\");
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) return base + "." + algo;
+    return base.substr(0, dot) + "." + algo + base.substr(dot);
+}
+
+std::string json_escape(const std::string& text) {
+    std::string out;
+    for (char c : text) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+void write_json(std::ostream& out, const CliOptions& opts, size_t process_count, const std::vector<RunResult>& results) {
+    out << "{\n  \"input\": \"" << json_escape(opts.input.empty() ? "random" : opts.input) << "\",\n"
+        << "  \"processes\": " << process_count << ",\n"
+        << "  \"quantum\": " << opts.quantum << ",\n"
+        << "  \"time_unit\": \"" << time_unit_name(opts.time_unit) << "\",\n";
+    if (opts.fork_at >= SimTime(0)) {
+        out << "  \"prefix\": \"" << json_escape(opts.prefix) << "\",\n"
+            << "  \"fork_at\": " << opts.fork_at << ",\n";
+    }
+    out
+        << "  \"results\": [";
+    for (size_t i = 0; i < results.size(); i++) {
+        const RunResult& r = results[i];
+        const AnalysisSummary& s = r.summary;
+        out << (i == 0 ? "\n" : ",\n")
+            << "    {\"algorithm\": \"" << r.algorithm->name << "\""
+            << ", \"title\": \"" << r.algorithm->title << "\""
+            << ", \"wall_ms\": " << r.wall_ms
+            << ", \"records\": " << s.records
+            << ", \"avg_response_time\": " << s.avg_response_time
+            << ", \"avg_turnaround_time\": " << s.avg_turnaround_time
+            << ", \"avg_waiting_time\": " << s.avg_waiting_time
+            << ", \"total_time\": " << s.total_time
+            << ", \"idle_time\": " << s.idle_time
+            << ", \"burst_time\": " << s.burst_time
+            << ", \"cpu_efficiency\": " << s.cpu_efficiency
+            << ", \"throughput\": " << s.throughput;
+        if (r.output.has_counters) {
+            const RunCounters& c = r.output.run_counters;
+            out << ", \"dispatches\": " << c.dispatches
+                << ", \"preemptions\": " << c.preemptions
+                << ", \"io_yields\": " << c.io_yields
+                << ", \"demotions\": " << c.demotions
+                << ", \"context_switches\": " << c.context_switches;
+        }
+        if (r.output.has_latency) {
+            const DecisionLatency& l = r.output.latency;
+            double per_ns = decision_ticks_per_ns();
+            out << ", \"pick_mean_ns\": " << l.pick.mean() / per_ns
+                << ", \"pick_p99_ns\": " << l.pick.percentile(0.99) / per_ns
+                << ", \"enqueue_mean_ns\": " << l.enqueue.mean() / per_ns;
+        }
+        if (r.output.has_cpu_stats) {
+            const MultiCpuStats& m = r.output.cpu_stats;
+            out << ", \"cpus\": " << m.cpus
+                << ", \"makespan\": " << m.makespan
+                << ", \"utilization\": " << m.utilization()
+                << ", \"fragmentation\": " << m.fragmentation()
+                << ", \"padding_time\": " << m.padding_time
+                << ", \"barrier_wait_time\": " << m.barrier_wait_time
+                << ", \"migrations\": " << m.migrations;
+            if (m.throttles > 0) {
+                out << ", \"throttles\": " << m.throttles << ", \"throttled_time\": " << m.throttled_time;
+            }
+            if (m.energy_model) {
+                double joules = m.energy() / ticks_per_second(opts.time_unit);
+                out << ", \"energy_j\": " << joules
+                    << ", \"energy_per_process_j\": " << joules / (double)process_count
+                    << ", \"idle_energy_share\": " << (m.energy() > 0 ? m.idle_energy / m.energy() : 0)
+                    << ", \"wake_time\": " << m.wake_time
+                    << ", \"wakeups\": " << m.wakeups
+                    << ", \"frequency_stall_time\": " << m.frequency_stall_time;
+            }
+            if (m.nodes > 1) {
+                out << ", \"nodes\": " << m.nodes
+                    << ", \"remote_share\": " << m.remote_share()
+                    << ", \"numa_stall_time\": " << m.numa_stall_time
+                    << ", \"llc_migrations\": " << m.llc_migrations
+                    << ", \"node_migrations\": " << m.node_migrations;
+            }
+        }
+        out << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+void write_csv(std::ostream& out, size_t process_count, const std::vector<RunResult>& results) {
+    out << "algorithm,processes,records,wall_ms,avg_response_time,avg_turnaround_time,avg_waiting_time,"
+           "total_time,idle_time,burst_time,cpu_efficiency,throughput\n";
+    for (const auto& r : results) {
+        const AnalysisSummary& s = r.summary;
+        out << r.algorithm->name << "," << process_count << "," << s.records << "," << r.wall_ms << ","
+            << s.avg_response_time << "," << s.avg_turnaround_time << "," << s.avg_waiting_time << ","
+            << s.total_time << "," << s.idle_time << "," << s.burst_time << ","
+            << s.cpu_efficiency << "," << s.throughput << "\n";
+    }
+}
+
+void write_text(std::ostream& out, const CliOptions& opts, size_t process_count, const std::vector<RunResult>& results) {
+    for (const auto& r : results) {
+        const AnalysisSummary& s = r.summary;
+        out << r.algorithm->title << " (" << r.algorithm->name << ")\n"
+            << "  Processes:               " << process_count << "\n"
+            << "  Chart records:           " << s.records << "\n"
+            << "  Wall time (ms):          " << r.wall_ms << "\n"
+            << "  Average Response Time:   " << s.avg_response_time << "\n"
+            << "  Average Turnaround Time: " << s.avg_turnaround_time << "\n"
+            << "  Average Waiting Time:    " << s.avg_waiting_time << "\n"
+            << "  Total Time:              " << s.total_time << "\n"
+            << "  Idle Time:               " << s.idle_time << "\n"
+            << "  Burst Time:              " << s.burst_time << "\n"
+            << "  Efficiency:              " << s.cpu_efficiency << "\n"
+            << "  Throughput:              " << s.throughput << " per second\n";
+        if (r.output.has_counters) {
+            const RunCounters& c = r.output.run_counters;
+            out << "  Dispatches:              " << c.dispatches << "\n"
+                << "  Preemptions:             " << c.preemptions << "\n"
+                << "  I/O Yields:              " << c.io_yields << "\n"
+                << "  Demotions:               " << c.demotions << "\n"
+                << "  Context Switches:        " << c.context_switches << "\n";
+        }
+        if (r.output.has_latency) {
+            const DecisionLatency& l = r.output.latency;
+            double per_ns = decision_ticks_per_ns();
+            out << "  Pick Latency (ns):       mean " << l.pick.mean() / per_ns << ", p99 "
+                << l.pick.percentile(0.99) / per_ns << "\n";
+            if (l.enqueue.samples > 0) out << "  Enqueue Latency (ns):    mean " << l.enqueue.mean() / per_ns << "\n";
+        }
+        if (r.output.has_cpu_stats) {
+            const MultiCpuStats& m = r.output.cpu_stats;
+            out << "  CPUs:                    " << m.cpus << "\n"
+                << "  Makespan:                " << m.makespan << "\n"
+                << "  Utilization:             " << m.utilization() << "\n"
+                << "  Fragmentation:           " << m.fragmentation() << "\n"
+                << "  Gang Padding:            " << m.padding_time << "\n"
+                << "  Barrier Wait:            " << m.barrier_wait_time << "\n"
+                << "  Migrations:              " << m.migrations << "\n";
+            if (m.throttles > 0) {
+                out << "  Throttles:               " << m.throttles << "\n"
+                    << "  Throttled Time:          " << m.throttled_time << "\n";
+            }
+            if (m.energy_model) {
+                double joules = m.energy() / ticks_per_second(opts.time_unit);
+                out << "  Energy (J):              " << joules << "\n"
+                    << "  Energy per Process (J):  " << joules / (double)process_count << "\n"
+                    << "  Idle Energy (J):         " << m.idle_energy / ticks_per_second(opts.time_unit) << "\n"
+                    << "  Wake Time:               " << m.wake_time << "\n"
+                    << "  Wake-ups:                " << m.wakeups << "\n"
+                    << "  Frequency Stall:         " << m.frequency_stall_time << "\n";
+            }
+            if (m.nodes > 1) {
+                out << "  NUMA Nodes:              " << m.nodes << "\n"
+                    << "  Remote Share:            " << m.remote_share() << "\n"
+                    << "  NUMA Stall:              " << m.numa_stall_time << "\n"
+                    << "  LLC Migrations:          " << m.llc_migrations << "\n"
+                    << "  Node Migrations:         " << m.node_migrations << "\n";
+            }
+        }
+    }
+}
+
+void write_share_class(std::ostream& out, const std::string& algo, const std::string& tickets, const ShareClass& c) {
+    out << algo << "," << tickets << "," << c.processes << "," << c.entitled << "," << c.received << ","
+        << c.relative_error << "," << c.mean_abs_error << "," << c.max_abs_error << "\n";
+}
+
+bool write_counters(const std::string& filename, const std::vector<Process>& processes,
+                    const std::vector<RunResult>& results) {
+    std::ofstream out(filename);
+    if (!out) return false;
+    out << "algorithm,pid,dispatches,preemptions,io_yields,demotions\n";
+    for (const auto& r : results) {
+        if (!r.output.has_counters) continue;
+        for (size_t i = 0; i < processes.size(); i++) {
+            const ProcessCounters& c = r.output.process_counters[i];
+            out << r.algorithm->name << "," << processes[i].pid << "," << c.dispatches << "," << c.preemptions << ","
+                << c.io_yields << "," << c.demotions << "\n";
+        }
+    }
+    return (bool)out;
+}
+
+void write_latency_row(std::ostream& out, const std::string& algo, const char* op, const std::string& length,
+                       const LatencyHistogram& h, double per_ns) {
+    out << algo << "," << op << "," << length << "," << h.samples << "," << h.mean() / per_ns << ","
+        << h.percentile(0.5) / per_ns << "," << h.percentile(0.9) / per_ns << "," << h.percentile(0.99) / per_ns
+        << "," << h.highest / per_ns << "\n";
+}
+
+// Overall rows per op, then the mean pick latency per power-of-two
+// ready-queue length ("queue_length" is the bin's lower bound)
+bool write_latency(const std::string& filename, const std::vector<RunResult>& results) {
+    std::ofstream out(filename);
+    if (!out) return false;
+    double per_ns = decision_ticks_per_ns();
+    out << "algorithm,op,queue_length,samples,mean_ns,p50_ns,p90_ns,p99_ns,max_ns\n";
+    for (const auto& r : results) {
+        if (!r.output.has_latency) continue;
+        const DecisionLatency& l = r.output.latency;
+        const std::string& name = r.algorithm->name;
+        if (l.enqueue.samples > 0) write_latency_row(out, name, "enqueue", "all", l.enqueue, per_ns);
+        write_latency_row(out, name, "pick", "all", l.pick, per_ns);
+        for (size_t b = 0; b < DecisionLatency::kLengthBins; b++) {
+            const LengthBin& bin = l.pick_by_length[b];
+            if (bin.samples == 0) continue;
+            out << name << ",pick," << (1ull << b) << "," << bin.samples << "," << bin.mean() / per_ns
+                << ",,,,\n";
+        }
+    }
+    return (bool)out;
+}
+
+// One row per bucket; "to" is exclusive
+bool write_histogram(const std::string& filename, const std::vector<RunResult>& results) {
+    std::ofstream out(filename);
+    if (!out) return false;
+    out << "algorithm,from,to,processes\n";
+    for (const auto& r : results) {
+        const TurnaroundHistogram& h = r.turnaround;
+        for (size_t b = 0; b < h.counts.size(); b++) {
+            SimTime from = h.lowest + h.width * (SimTime::rep)b;
+            out << r.algorithm->name << "," << from << "," << from + h.width << "," << h.counts[b] << "\n";
+        }
+    }
+    return (bool)out;
+}
+
+// Mean, 95% CI half-width, standard deviation and range of every metric
+void write_replications(std::ostream& out, const CliOptions& opts, const std::vector<ReplicationResult>& results) {
+    if (opts.metrics == "csv") {
+        out << "algorithm,metric,replications,mean,ci95,stddev,min,max\n";
+        for (const auto& r : results) {
+            for (size_t m = 0; m < kReplicatedMetricCount; m++) {
+                const MetricSketch& s = r.metrics[m];
+                out << r.config.algorithm << "," << replicated_metric_name((ReplicatedMetric)m) << "," << s.count()
+                    << "," << s.mean() << "," << s.ci95() << "," << s.stddev() << "," << s.min() << "," << s.max()
+                    << "\n";
+            }
+        }
+    } else if (opts.metrics == "json") {
+        out << "{\n  \"processes\": " << opts.random_count << ",\n"
+            << "  \"replications\": " << opts.replications << ",\n"
+            << "  \"seed\": " << opts.seed << ",\n"
+            << "  \"quantum\": " << opts.quantum << ",\n"
+            << "  \"results\": [";
+        for (size_t i = 0; i < results.size(); i++) {
+            out << (i == 0 ? "\n" : ",\n") << "    {\"algorithm\": \"" << results[i].config.algorithm << "\"";
+            for (size_t m = 0; m < kReplicatedMetricCount; m++) {
+                const MetricSketch& s = results[i].metrics[m];
+                out << ", \"" << replicated_metric_name((ReplicatedMetric)m) << "\": {\"mean\": " << s.mean()
+                    << ", \"ci95\": " << s.ci95() << ", \"stddev\": " << s.stddev() << "}";
+            }
+            out << "}";
+        }
+        out << "\n  ]\n}\n";
+    } else {
+        for (const auto& r : results) {
+            out << r.config.algorithm << " (" << opts.replications << " replications of " << opts.random_count
+                << " processes)\n";
+            for (size_t m = 0; m < kReplicatedMetricCount; m++) {
+                const MetricSketch& s = r.metrics[m];
+                out << "  " << replicated_metric_name((ReplicatedMetric)m) << ": " << s.mean() << " +/- " << s.ci95()
+                    << "\n";
+            }
+        }
+    }
+}
+
+bool write_shares(const std::string& filename, const std::vector<Process>& processes,
+                  const std::vector<RunResult>& results) {
+    std::ofstream out(filename);
+    if (!out) return false;
+    out << "algorithm,tickets,processes,entitled,received,relative_error,mean_abs_error,max_abs_error\n";
+    for (const auto& r : results) {
+        const SegmentTable segments = r.output.has_slices ? r.output.slices : segments_from_chart(r.output.records);
+        ShareReport report = share_report(segments, processes);
+        for (const auto& c : report.classes) write_share_class(out, r.algorithm->name, std::to_string(c.tickets), c);
+        write_share_class(out, r.algorithm->name, "all", report.overall);
+    }
+    return (bool)out;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    CliOptions opts;
+    if (!parse_args(argc, argv, opts)) {
+        usage(std::cerr);
+        return 1;
+    }
+
+    const SchedulerRegistry& registry = SchedulerRegistry::instance();
+    SchedulerParams explicit_params;
+    std::string param_error;
+    if (!parse_scheduler_params(opts.params, explicit_params, param_error)) {
+        std::cerr << "sched_cli: --param: " << param_error << "\n";
+        return 1;
+    }
+
+    std::vector<const SchedulerInfo*> selected;
+    for (const auto& name : opts.algos) {
+        if (name == "all") {
+            for (const auto& a : registry.all()) selected.push_back(&a);
+            continue;
+        }
+        const SchedulerInfo* algo = registry.find(name);
+        if (algo == nullptr) {
+            std::cerr << "sched_cli: unknown algorithm " << name << " (see --list)\n";
+            return 1;
+        }
+        selected.push_back(algo);
+    }
+    const SchedulerInfo* prefix = opts.fork_at >= SimTime(0) ? registry.find(opts.prefix) : nullptr;
+    for (const auto& kv : explicit_params.all()) {
+        bool used = std::any_of(selected.begin(), selected.end(),
+                                [&](const SchedulerInfo* a) { return a->find_param(kv.first) != nullptr; }) ||
+                    (prefix != nullptr && prefix->find_param(kv.first) != nullptr);
+        if (!used) {
+            std::cerr << "sched_cli: no selected algorithm takes parameter " << kv.first << "\n";
+            return 1;
+        }
+    }
+
+    // Per-run records go through one writer thread, so concurrent runs
+    // never share the stream
+    std::ofstream raw_file;
+    std::unique_ptr<ResultWriter> raw;
+    if (!opts.raw.empty()) {
+        raw_file.open(opts.raw, std::ios::binary);
+        if (!raw_file) {
+            std::cerr << "sched_cli: cannot write " << opts.raw << "\n";
+            return 2;
+        }
+        std::vector<std::string> names;
+        for (const SchedulerInfo* algo : selected) names.push_back(algo->name);
+        raw.reset(new ResultWriter(raw_file, opts.raw_format, names));
+    }
+    auto finish_raw = [&]() {
+        if (raw == nullptr || raw->finish()) return true;
+        std::cerr << "sched_cli: cannot write " << opts.raw << "\n";
+        return false;
+    };
+
+    if (opts.replications > 0) {
+        std::vector<ReplicationConfig> configs;
+        for (const SchedulerInfo* algo : selected) configs.push_back({algo->name, params_for(*algo, opts, explicit_params)});
+        ReplicationOptions replication;
+        replication.replications = (size_t)opts.replications;
+        replication.processes = opts.random_count;
+        replication.base_seed = opts.seed;
+        replication.max_threads = opts.max_threads;
+        replication.threads = opts.threads;
+        replication.time_unit = opts.time_unit;
+        replication.stream = raw.get();
+        std::vector<ReplicationResult> replicated;
+        std::string error;
+        bool ran = run_replications(configs, replication, replicated, error);
+        bool raw_ok = finish_raw();
+        if (!ran) {
+            std::cerr << "sched_cli: " << error << "\n";
+            return 1;
+        }
+        std::ofstream file;
+        if (!opts.output.empty()) file.open(opts.output);
+        std::ostream& out = opts.output.empty() ? std::cout : file;
+        write_replications(out, opts, replicated);
+        out.flush();
+        if (!out) {
+            std::cerr << "sched_cli: cannot write " << opts.output << "\n";
+            return 2;
+        }
+        return raw_ok ? 0 : 2;
+    }
+
+    std::vector<Process> processes;
+    if (!opts.input.empty()) {
+        std::string error;
+        if (!load_workload(opts.input, processes, error)) {
+            std::cerr << "sched_cli: " << error << "\n";
+            return 2;
+        }
+    } else {
+        processes = generate_random_workload(opts.random_count, opts.seed);
+        if (opts.max_threads > 1) assign_random_threads(processes, opts.max_threads, opts.seed);
+    }
+    if (processes.empty()) {
+        std::cerr << "sched_cli: workload is empty\n";
+        return 2;
+    }
+    CpuConstraints constraints;
+    if (!opts.cpu_limits.empty()) {
+        std::string error;
+        if (!load_cpu_constraints(opts.cpu_limits, processes, constraints, error)) {
+            std::cerr << "sched_cli: " << error << "\n";
+            return 2;
+        }
+        for (const SchedulerInfo* algo : selected) {
+            const ParamSpec* cpus = algo->find_param("cpus");
+            if (cpus == nullptr) continue;
+            int machine = params_for(*algo, opts, explicit_params).get("cpus", cpus->default_value);
+            if (!check_affinity(constraints, processes, machine, error)) {
+                std::cerr << "sched_cli: " << algo->name << ": " << opts.cpu_limits << ": " << error << "\n";
+                return 2;
+            }
+        }
+    }
+    if (!opts.save_workload.empty() && !save_workload_binary(opts.save_workload, processes)) {
+        std::cerr << "sched_cli: cannot write " << opts.save_workload << "\n";
+        return 2;
+    }
+
+    // With --fork-at every algorithm continues one shared snapshot; its
+    // arrays are copy-on-write, so the forks only copy what they change
+    SimulationSnapshot snapshot;
+    if (opts.fork_at >= SimTime(0)) {
+        std::string error;
+        if (prefix == nullptr ||
+            !registry.run_until(opts.prefix, processes, params_for(*prefix, opts, explicit_params), opts.fork_at,
+                                snapshot, error)) {
+            std::cerr << "sched_cli: --prefix: " << (prefix == nullptr ? "unknown algorithm " + opts.prefix : error)
+                      << "\n";
+            return 1;
+        }
+    }
+
+    // Algorithms are independent, so they can run side by side
+    std::vector<RunResult> results(selected.size());
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (size_t i = next++; i < selected.size(); i = next++) {
+            RunResult& r = results[i];
+            r.algorithm = selected[i];
+            if (!opts.latency.empty()) r.output.latency_sample_every = (uint32_t)opts.latency_every;
+            r.output.constraints = &constraints;
+            SchedulerParams params = params_for(*r.algorithm, opts, explicit_params);
+            auto start = std::chrono::steady_clock::now();
+            bool ran = opts.fork_at >= SimTime(0)
+                           ? registry.resume(r.algorithm->name, snapshot, params, r.output, r.error)
+                           : registry.run(r.algorithm->name, processes, params, r.output, r.error);
+            auto end = std::chrono::steady_clock::now();
+            r.wall_ms = std::chrono::duration<double, std::milli>(end - start).count();
+            if (!ran) continue;
+            GranttAnalysis analysis(r.output.records, processes, opts.time_unit);
+            r.summary = analysis.summary();
+            if (r.output.has_cpu_stats) apply_machine_totals(r.summary, r.output.cpu_stats);
+            if (!opts.histogram.empty()) r.turnaround = analysis.turnaround_histogram(opts.histogram_buckets);
+            if (raw != nullptr) {
+                ResultRecord record = result_record((uint32_t)i, r.summary);
+                record.seed = opts.input.empty() ? opts.seed : 0;
+                record.wall_ms = r.wall_ms;
+                raw->push(record);
+            }
+        }
+    };
+
+    size_t thread_count = std::min<size_t>(opts.threads, selected.size());
+    std::vector<std::thread> pool;
+    for (size_t t = 1; t < thread_count; t++) pool.emplace_back(worker);
+    worker();
+    for (auto& t : pool) t.join();
+    bool ok = finish_raw();
+
+    for (const auto& r : results) {
+        if (!r.error.empty()) {
+            std::cerr << "sched_cli: " << r.error << "\n";
+            return 1;
+        }
+        if (r.summary.overflow) {
+            std::cerr << "sched_cli: " << r.algorithm->name << ": a time total overflowed and was saturated\n";
+        }
+    }
+
+    std::ofstream gantt_file;
+    std::ostream* gantt_out = &std::cerr;
+    if (!opts.gantt.empty() && opts.gantt != "-") {
+        gantt_file.open(opts.gantt);
+        gantt_out = &gantt_file;
+        if (!gantt_file) {
+            std::cerr << "sched_cli: cannot write " << opts.gantt << "\n";
+            ok = false;
+        }
+    }
+
+    for (const auto& r : results) {
+        if (opts.gantt.empty() && opts.trace.empty()) break;
+        // Prefer the scheduler's own slices; otherwise rebuild from the chart
+        SegmentTable segments = r.output.has_slices ? r.output.slices : segments_from_chart(r.output.records);
+        if (!opts.gantt.empty() && *gantt_out) {
+            *gantt_out << r.algorithm->title << "\n";
+            GanttRenderer().print(segments, *gantt_out);
+        }
+        if (!opts.trace.empty()) {
+            std::string filename = trace_filename(opts.trace, r.algorithm->name, results.size() > 1);
+            if (!export_chrome_trace(segments, filename, microseconds_per_tick(opts.time_unit))) {
+                std::cerr << "sched_cli: cannot write " << filename << "\n";
+                ok = false;
+            }
+        }
+    }
+
+    if (!opts.counters.empty() && !write_counters(opts.counters, processes, results)) {
+        std::cerr << "sched_cli: cannot write " << opts.counters << "\n";
+        ok = false;
+    }
+    if (!opts.shares.empty() && !write_shares(opts.shares, processes, results)) {
+        std::cerr << "sched_cli: cannot write " << opts.shares << "\n";
+        ok = false;
+    }
+    if (!opts.latency.empty() && !write_latency(opts.latency, results)) {
+        std::cerr << "sched_cli: cannot write " << opts.latency << "\n";
+        ok = false;
+    }
+    if (!opts.histogram.empty() && !write_histogram(opts.histogram, results)) {
+        std::cerr << "sched_cli: cannot write " << opts.histogram << "\n";
+        ok = false;
+    }
+    if (!opts.profile.empty()) {
+        if (!instrumentation_enabled()) {
+            std::cerr << "sched_cli: --profile: ";
+            print_instrumentation(std::cerr, InstrumentationReport());
+        } else if (opts.profile == "-") {
+            print_instrumentation(std::cerr, instrumentation_report());
+        } else {
+            std::ofstream profile_file(opts.profile);
+            print_instrumentation(profile_file, instrumentation_report());
+            if (!profile_file) {
+                std::cerr << "sched_cli: cannot write " << opts.profile << "\n";
+                ok = false;
+            }
+        }
+    }
+
+    std::ofstream file;
+    std::ostream* out = &std::cout;
+    if (!opts.output.empty()) {
+        file.open(opts.output);
+        if (!file) {
+            std::cerr << "sched_cli: cannot write " << opts.output << "\n";
+            return 2;
+        }
+        out = &file;
+    }
+
+    if (opts.metrics == "json") {
+        write_json(*out, opts, processes.size(), results);
+    } else if (opts.metrics == "csv") {
+        write_csv(*out, processes.size(), results);
+    } else {
+        write_text(*out, opts, processes.size(), results);
+    }
+    out->flush();
+
+    return ok && *out ? 0 : 2;
+}
@@ -0,0 +1,1062 @@
+// Behaviour tests for libsched, run by ctest. Each test is a plain
+// function; EXPECT records a failed condition and carries on, so one run
+// reports every broken expectation. The exit status is non-zero if any
+// test failed.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "ChromeTraceWriter.h"
+#include "CpuConstraints.h"
+#include "DecisionLatency.h"
+#include "Energy.h"
+#include "GanttRenderer.h"
+#include "IncrementalSimulation.h"
+#include "MetricKernels.h"
+#include "Replication.h"
+#include "ResultStream.h"
+#include "SchedulerPolicies.h"
+#include "SchedulerRegistry.h"
+#include "ShareReport.h"
+#include "Topology.h"
+#include "Workload.h"
+
+namespace {
+
+int failed_checks = 0;
+
+bool expect(bool ok, const char* condition, const char* file, int line) {
+    if (!ok) {
+        std::cerr << file << ":" << line << ": expected " << condition << "\n";
+        failed_checks++;
+    }
+    return ok;
+}
+
+#define EXPECT(condition) expect((condition), #condition, __FILE__, __LINE__)
+
+// ---------------------------------------------------------------------------
+// Helpers
+// ---------------------------------------------------------------------------
+
+Process make_process(int number, SimTime::rep arrival, SimTime::rep cpu1, SimTime::rep io = 0,
+                     SimTime::rep cpu2 = 0, int priority = 0) {
+    return Process("P" + std::to_string(number), SimTime(arrival), SimTime(cpu1), SimTime(io), SimTime(cpu2),
+                   priority);
+}
+
+bool run(const std::string& algorithm, const std::vector<Process>& workload, const SchedulerParams& params,
+         ScheduleCollector& output) {
+    std::string error;
+    bool ok = SchedulerRegistry::instance().run(algorithm, workload, params, output, error);
+    if (!ok) std::cerr << algorithm << ": " << error << "\n";
+    return ok;
+}
+
+const ProcessGrantInfo* record_of(const std::vector<ProcessGrantInfo>& records, const std::string& pid) {
+    for (const auto& r : records) {
+        if (r.process.pid == pid) return &r;
+    }
+    return nullptr;
+}
+
+bool same_record(const ProcessGrantInfo& a, const ProcessGrantInfo& b) {
+    return a.process.pid == b.process.pid && a.cpu_start_time1 == b.cpu_start_time1 &&
+           a.cpu_end_time1 == b.cpu_end_time1 && a.io_start_time == b.io_start_time &&
+           a.io_end_time == b.io_end_time && a.cpu_start_time2 == b.cpu_start_time2 &&
+           a.cpu_end_time2 == b.cpu_end_time2;
+}
+
+bool same_records(const std::vector<ProcessGrantInfo>& a, const std::vector<ProcessGrantInfo>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); i++) {
+        if (!same_record(a[i], b[i])) return false;
+    }
+    return true;
+}
+
+bool same_process(const Process& a, const Process& b) {
+    return a.pid == b.pid && a.arrival_time == b.arrival_time && a.cpu_burst_time1 == b.cpu_burst_time1 &&
+           a.io_time == b.io_time && a.cpu_burst_time2 == b.cpu_burst_time2 && a.priority == b.priority &&
+           a.threads == b.threads;
+}
+
+// A file in the temporary directory, removed when the test is done
+struct TempFile {
+    std::string path;
+
+    explicit TempFile(const std::string& name)
+        : path((std::filesystem::temp_directory_path() /
+                ("sched_tests_" + std::to_string(getpid()) + "_" + name)).string()) {}
+    ~TempFile() { std::remove(path.c_str()); }
+};
+
+// ---------------------------------------------------------------------------
+// Library and registry
+// ---------------------------------------------------------------------------
+
+// Every scheduler registers itself from its own object file, so linking
+// the static libsched has to keep all of them
+void test_library_registers_every_scheduler() {
+    const char* names[] = {"fcfs", "fcfs-preemptive", "sjf", "rr", "priority", "priority-preemptive", "mlfq",
+                           "policy-fcfs", "policy-fcfs-preemptive", "policy-sjf", "policy-rr", "policy-priority",
+                           "policy-priority-preemptive", "policy-mlfq", "hrrn", "srtf", "lottery", "stride",
+                           "smp", "gang"};
+    std::vector<Process> workload = {make_process(1, 0, 5, 2, 3), make_process(2, 1, 4, 1, 2)};
+    for (const char* name : names) {
+        if (!EXPECT(SchedulerRegistry::instance().find(name) != nullptr)) {
+            std::cerr << "  " << name << "\n";
+            continue;
+        }
+        ScheduleCollector output;
+        if (!EXPECT(run(name, workload, SchedulerParams(), output))) continue;
+        EXPECT(record_of(output.records, "P1") != nullptr && record_of(output.records, "P2") != nullptr);
+    }
+}
+
+// A private registry, so the checks do not depend on what libsched holds
+void test_registry_and_params() {
+    SchedulerRegistry registry;
+    SchedulerParams received;
+    auto probe = [&received](const std::vector<Process>&, const SchedulerParams& params, ScheduleSink&) {
+        received = params;
+    };
+    SchedulerInfo info;
+    info.name = "probe";
+    info.title = "Probe";
+    info.params = {{"quantum", "slice", 4, 1, 100}, {"levels", "queues", 0, 0, 8}};
+    info.run = probe;
+    EXPECT(registry.add(info));
+    EXPECT(!registry.add(info));
+    info.name = "another";
+    EXPECT(registry.add(info));
+    EXPECT(registry.all().size() == 2 && registry.all()[0].name == "another");
+    EXPECT(registry.find("probe") != nullptr && registry.find("missing") == nullptr);
+
+    // Defaults fill what is not given
+    ScheduleCollector output;
+    std::string error;
+    SchedulerParams params;
+    params.set("levels", 3);
+    EXPECT(registry.run("probe", {}, params, output, error));
+    EXPECT(received.get("quantum") == 4 && received.get("levels") == 3 && received.all().size() == 2);
+
+    // Unknown names and out-of-range values are refused before the run
+    received = SchedulerParams();
+    EXPECT(!registry.run("missing", {}, SchedulerParams(), output, error) && error == "unknown algorithm missing");
+    SchedulerParams unknown;
+    unknown.set("speed", 1);
+    EXPECT(!registry.run("probe", {}, unknown, output, error) && error == "probe has no parameter speed");
+    for (int bad : {0, 101}) {
+        SchedulerParams out_of_range;
+        out_of_range.set("quantum", bad);
+        EXPECT(!registry.run("probe", {}, out_of_range, output, error) && error == "probe: quantum must be in [1, 100]");
+    }
+    EXPECT(received.all().empty());
+
+    // Run-only algorithms cannot pause
+    SimulationSnapshot snapshot;
+    EXPECT(!registry.run_until("probe", {}, SchedulerParams(), SimTime(5), snapshot, error));
+
+    SchedulerParams parsed;
+    EXPECT(parse_scheduler_params("quantum=4,,levels=-2", parsed, error));
+    EXPECT(parsed.get("quantum") == 4 && parsed.get("levels") == -2 && parsed.all().size() == 2);
+    for (const char* bad : {"quantum", "=4", "quantum=", "quantum=4x", "quantum=99999999999"}) {
+        SchedulerParams rejected;
+        if (!EXPECT(!parse_scheduler_params(bad, rejected, error))) std::cerr << "  " << bad << "\n";
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Charts
+// ---------------------------------------------------------------------------
+
+ProcessGrantInfo chart_record(int number, SimTime::rep cpu1_start, SimTime::rep cpu1_end, SimTime::rep io_start = -1,
+                              SimTime::rep io_end = -1, SimTime::rep cpu2_start = -1, SimTime::rep cpu2_end = -1) {
+    return ProcessGrantInfo(make_process(number, 0, cpu1_end - cpu1_start), SimTime(cpu1_start), SimTime(io_start),
+                            SimTime(cpu2_start), SimTime(cpu1_end), SimTime(io_end), SimTime(cpu2_end));
+}
+
+void test_gantt_rendering() {
+    // Rows come out sorted by ID, one cell per tick while the chart fits
+    std::vector<ProcessGrantInfo> chart = {chart_record(2, 0, 3, 3, 5, 5, 7), chart_record(1, 3, 5)};
+    SegmentTable table = segments_from_chart(chart);
+    EXPECT(table.rows == std::vector<std::string>({"P1", "P2"}));
+    EXPECT(table.end_time == SimTime(7));
+    EXPECT(GanttRenderer(10).render(table) == "     0    5  \n"
+                                              "     |    |  \n"
+                                              "P1 :    CC  \n"
+                                              "P2 : CCCIICC\n");
+
+    // Scaled down, each cell shows what fills most of its ticks (6 of the
+    // 10 in cell 4 are CPU)
+    std::vector<ProcessGrantInfo> long_chart = {chart_record(1, 0, 46, 46, 100)};
+    std::string scaled = GanttRenderer(10).render(segments_from_chart(long_chart));
+    EXPECT(scaled.rfind("Scale: 1 cell = 10 ticks\n", 0) == 0);
+    EXPECT(scaled.substr(scaled.size() - 16) == "P1 : CCCCCIIIII\n");
+
+    // Overlapping segments of one kind get separate lanes, lowest free first
+    std::vector<ProcessGrantInfo> overlapping = {chart_record(1, 0, 4), chart_record(2, 2, 6), chart_record(3, 4, 8),
+                                                 chart_record(4, 5, 7), chart_record(5, 6, 9)};
+    SegmentTable lanes = segments_from_chart(overlapping);
+    std::vector<int> expected = {0, 1, 0, 2, 1};
+    for (const auto& seg : lanes.segments) EXPECT(seg.resource == expected[seg.row]);
+    EXPECT(segments_from_chart({}).rows.empty());
+    EXPECT(GanttRenderer().render(SegmentTable()).empty());
+}
+
+void test_chrome_trace() {
+    // One named track per CPU and I/O device, slices named after the
+    // process (escaped), times scaled to microseconds
+    std::vector<std::string> rows = {"P\"1"};
+    std::ostringstream json;
+    {
+        ChromeTraceWriter writer(json, rows, 0.5);
+        writer.add({Segment(0, 0, SegmentKind::Cpu, SimTime(0), SimTime(3)),
+                    Segment(0, 0, SegmentKind::Io, SimTime(3), SimTime(5)),
+                    Segment(0, 1, SegmentKind::Cpu, SimTime(5), SimTime(6))});
+    }
+    EXPECT(json.str() ==
+           "{\"displayTimeUnit\":\"ms\",\"traceEvents\":["
+           "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"CPUs\"}},\n"
+           "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":2,\"args\":{\"name\":\"I/O devices\"}},\n"
+           "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"CPU 0\"}},\n"
+           "{\"name\":\"P\\\"1\",\"cat\":\"cpu\",\"ph\":\"X\",\"ts\":0,\"dur\":1.500,\"pid\":1,\"tid\":0},\n"
+           "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":2,\"tid\":0,\"args\":{\"name\":\"I/O 0\"}},\n"
+           "{\"name\":\"P\\\"1\",\"cat\":\"io\",\"ph\":\"X\",\"ts\":1.500,\"dur\":1,\"pid\":2,\"tid\":0},\n"
+           "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"CPU 1\"}},\n"
+           "{\"name\":\"P\\\"1\",\"cat\":\"cpu\",\"ph\":\"X\",\"ts\":2.500,\"dur\":0.500,\"pid\":1,\"tid\":1}\n"
+           "]}\n");
+
+    // Past one chunk the writer streams; the document still holds every
+    // slice once and is closed exactly once
+    std::vector<Segment> many;
+    for (int i = 0; i < 40000; i++) many.emplace_back(0, 0, SegmentKind::Cpu, SimTime(i), SimTime(i + 1));
+    std::ostringstream big;
+    ChromeTraceWriter writer(big, rows);
+    writer.add(many);
+    writer.finish();
+    writer.finish();
+    std::string text = big.str();
+    EXPECT(text.size() > ChromeTraceWriter::kChunkSize);
+    size_t slices = 0;
+    for (size_t at = text.find("\"ph\":\"X\""); at != std::string::npos; at = text.find("\"ph\":\"X\"", at + 1)) slices++;
+    EXPECT(slices == many.size());
+    EXPECT(text.size() >= 4 && text.compare(text.size() - 4, 4, "\n]}\n") == 0);
+
+    // Overlapping chart records land on separate tracks
+    TempFile trace("trace.json");
+    std::vector<ProcessGrantInfo> chart = {chart_record(1, 0, 4), chart_record(2, 2, 6)};
+    if (!EXPECT(export_chrome_trace(segments_from_chart(chart), trace.path))) return;
+    std::ifstream in(trace.path);
+    std::string exported((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    EXPECT(exported.find("\"name\":\"P2\",\"cat\":\"cpu\",\"ph\":\"X\",\"ts\":2,\"dur\":4,\"pid\":1,\"tid\":1}") !=
+           std::string::npos);
+    EXPECT(!export_chrome_trace(SegmentTable(), "/nonexistent-directory/trace.json"));
+}
+
+// ---------------------------------------------------------------------------
+// Policies
+// ---------------------------------------------------------------------------
+
+// Everyone runnable for the whole run, so each ticket class should get
+// its ticket share of the CPU
+void test_proportional_shares() {
+    std::vector<Process> workload;
+    const int tickets[] = {1, 2, 4, 8};
+    int n = 0;
+    for (int t : tickets) {
+        for (int k = 0; k < 4; k++) {
+            n++;
+            workload.push_back(make_process(n, 0, 4000, 0, 0, t));
+        }
+    }
+
+    for (const char* algorithm : {"stride", "lottery"}) {
+        SchedulerParams params;
+        params.set("quantum", 1);
+        ScheduleCollector output;
+        if (!EXPECT(run(algorithm, workload, params, output))) continue;
+        EXPECT(output.has_slices);
+        ShareReport report = share_report(output.slices, workload);
+        EXPECT(report.classes.size() == 4);
+        // Stride is deterministic and exact to within a few quanta;
+        // lottery only converges on its shares
+        double limit = std::string(algorithm) == "stride" ? 0.001 : 0.05;
+        for (const auto& c : report.classes) {
+            if (!EXPECT(std::abs(c.relative_error) < limit)) {
+                std::cerr << "  " << algorithm << " class of " << c.tickets << " tickets: error "
+                          << c.relative_error << "\n";
+            }
+        }
+    }
+}
+
+// More tickets than kStrideOne once gave a stride of 0 and a division by
+// zero when charging
+void test_stride_huge_tickets() {
+    std::vector<Process> workload = {make_process(1, 0, 5, 0, 0, 2000000), make_process(2, 1, 5, 0, 0, 3),
+                                     make_process(3, 0, 6, 0, 0, std::numeric_limits<int>::max())};
+    ScheduleCollector output;
+    if (!EXPECT(run("stride", workload, SchedulerParams(), output))) return;
+    // The 3-ticket one gets its turn on joining, then waits for both big ones
+    EXPECT(record_of(output.records, "P1")->cpu_end_time1 < SimTime(16));
+    EXPECT(record_of(output.records, "P3")->cpu_end_time1 < SimTime(16));
+    EXPECT(record_of(output.records, "P2")->cpu_end_time1 == SimTime(16));
+}
+
+// A waited B beats a shorter C that only just arrived; SJF would take C
+void test_hrrn_order() {
+    std::vector<Process> workload = {make_process(1, 0, 30), make_process(2, 1, 10), make_process(3, 25, 6)};
+
+    ScheduleCollector hrrn;
+    if (EXPECT(run("hrrn", workload, SchedulerParams(), hrrn))) {
+        EXPECT(record_of(hrrn.records, "P2")->cpu_start_time1 == SimTime(30));
+        EXPECT(record_of(hrrn.records, "P3")->cpu_start_time1 == SimTime(40));
+    }
+
+    ScheduleCollector sjf;
+    if (EXPECT(run("policy-sjf", workload, SchedulerParams(), sjf))) {
+        EXPECT(record_of(sjf.records, "P3")->cpu_start_time1 == SimTime(30));
+        EXPECT(record_of(sjf.records, "P2")->cpu_start_time1 == SimTime(36));
+    }
+}
+
+// The queue directly: each bucket stays in ready order whatever order
+// tasks are pushed in, and a pick is within 1 + 1/kGrowth of the best ratio
+void test_response_ratio_queue() {
+    auto task = [](int index, SimTime::rep ready_since, SimTime::rep burst) {
+        Task t;
+        t.index = index;
+        t.ready_since = SimTime(ready_since);
+        t.remaining = SimTime(burst);
+        return t;
+    };
+    ResponseRatioQueue refilled;
+    refilled.push(task(0, 20, 10));
+    refilled.push(task(1, 30, 10));
+    refilled.push(task(2, 5, 10));   // Readied earlier than those queued, as on a restore
+    EXPECT(refilled.pop_at(SimTime(40)) == 2);
+    EXPECT(refilled.pop_at(SimTime(40)) == 0);
+    EXPECT(refilled.pop_at(SimTime(40)) == 1);
+
+    std::mt19937_64 rng(3);
+    const SimTime now(2000000000);
+    std::vector<Task> tasks;
+    ResponseRatioQueue queue;
+    for (int i = 0; i < 500; i++) {
+        SimTime::rep burst = (SimTime::rep)std::exp2((double)(rng() % 3000) / 100);   // 1 to 2^30
+        tasks.push_back(task(i, (SimTime::rep)(rng() % 1000000000), std::max<SimTime::rep>(burst, 1)));
+        queue.push(tasks.back());
+    }
+    auto ratio = [&](const Task& t) { return (double)(now - t.ready_since).ticks() / t.remaining.ticks(); };
+    std::vector<bool> taken(tasks.size(), false);
+    bool close_enough = true;
+    while (!queue.empty()) {
+        double best = 0;
+        for (size_t i = 0; i < tasks.size(); i++) {
+            if (!taken[i]) best = std::max(best, ratio(tasks[i]));
+        }
+        int picked = queue.pop_at(now);
+        taken[picked] = true;
+        close_enough = close_enough && ratio(tasks[picked]) * (1 + 1.0 / ResponseRatioQueue::kGrowth) >= best;
+    }
+    EXPECT(close_enough);
+}
+
+void test_srtf_preemption() {
+    // P2 arrives needing less than P1 has left and takes the CPU; P3 does not
+    std::vector<Process> workload = {make_process(1, 0, 10), make_process(2, 2, 3), make_process(3, 3, 20)};
+    ScheduleCollector output;
+    if (!EXPECT(run("srtf", workload, SchedulerParams(), output))) return;
+    const ProcessGrantInfo* p1 = record_of(output.records, "P1");
+    const ProcessGrantInfo* p2 = record_of(output.records, "P2");
+    const ProcessGrantInfo* p3 = record_of(output.records, "P3");
+    EXPECT(p1->cpu_start_time1 == SimTime(0));
+    EXPECT(p2->cpu_start_time1 == SimTime(2));
+    EXPECT(p2->cpu_end_time1 == SimTime(5));
+    EXPECT(p1->cpu_end_time1 == SimTime(13));
+    EXPECT(p3->cpu_start_time1 == SimTime(13));
+    EXPECT(output.run_counters.preemptions == 1);
+
+    ScheduleCollector fcfs;
+    if (EXPECT(run("policy-fcfs", workload, SchedulerParams(), fcfs))) {
+        EXPECT(record_of(fcfs.records, "P2")->cpu_start_time1 == SimTime(10));
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Snapshots and incremental re-simulation
+// ---------------------------------------------------------------------------
+
+void test_snapshot_resume_matches_full_run() {
+    const SchedulerRegistry& registry = SchedulerRegistry::instance();
+    std::vector<Process> workload = generate_random_workload(300, 11, 400);
+    std::string error;
+
+    for (const char* algorithm : {"policy-fcfs", "policy-rr", "srtf", "hrrn", "stride", "lottery", "policy-mlfq"}) {
+        ScheduleCollector full;
+        if (!EXPECT(run(algorithm, workload, SchedulerParams(), full))) continue;
+
+        // Paused twice on the way, then finished
+        SimulationSnapshot first, second;
+        EXPECT(registry.run_until(algorithm, workload, SchedulerParams(), SimTime(250), first, error));
+        EXPECT(registry.resume_until(algorithm, first, SchedulerParams(), SimTime(900), second, error));
+        ScheduleCollector resumed;
+        EXPECT(registry.resume(algorithm, second, SchedulerParams(), resumed, error));
+        if (!EXPECT(same_records(full.records, resumed.records))) std::cerr << "  " << algorithm << "\n";
+    }
+}
+
+void test_snapshot_fork() {
+    const SchedulerRegistry& registry = SchedulerRegistry::instance();
+    std::vector<Process> workload = generate_random_workload(200, 5, 300);
+    std::string error;
+
+    SimulationSnapshot prefix;
+    if (!EXPECT(registry.run_until("policy-fcfs", workload, SchedulerParams(), SimTime(500), prefix, error))) return;
+    EXPECT(!prefix.finished());
+
+    // The snapshot is shared, not consumed: both branches, and a repeat of
+    // one, start from the same state
+    ScheduleCollector rr, sjf, rr_again;
+    EXPECT(registry.resume("policy-rr", prefix, SchedulerParams(), rr, error));
+    EXPECT(registry.resume("policy-sjf", prefix, SchedulerParams(), sjf, error));
+    EXPECT(registry.resume("policy-rr", prefix, SchedulerParams(), rr_again, error));
+    EXPECT(same_records(rr.records, rr_again.records));
+    EXPECT(!same_records(rr.records, sjf.records));
+
+    // Whatever FCFS finished before the fork is the same in every branch
+    ScheduleCollector fcfs;
+    if (!EXPECT(run("policy-fcfs", workload, SchedulerParams(), fcfs))) return;
+    size_t finished_before = 0;
+    for (const auto& r : fcfs.records) {
+        if (r.cpu_end_time2 >= SimTime(500) || r.cpu_end_time2 < SimTime(0)) continue;
+        finished_before++;
+        EXPECT(same_record(r, *record_of(rr.records, r.process.pid)));
+        EXPECT(same_record(r, *record_of(sjf.records, r.process.pid)));
+    }
+    EXPECT(finished_before > 0);
+}
+
+void test_incremental_simulation() {
+    std::vector<Process> workload = generate_random_workload(400, 3, 1000);
+    SchedulerParams params;
+    params.set("quantum", 3);
+    std::string error;
+
+    IncrementalSimulation sim(16);
+    if (!EXPECT(sim.start("policy-rr", params, workload, error))) return;
+    EXPECT(sim.checkpoint_count() > 1);
+
+    auto matches_full_run = [&](const std::vector<Process>& edited) {
+        ScheduleCollector full;
+        return run("policy-rr", edited, params, full) && same_records(full.records, sim.records());
+    };
+
+    // The latest arrival changes: only the tail is re-run
+    size_t last = 0;
+    for (size_t i = 0; i < workload.size(); i++) {
+        if (workload[i].arrival_time > workload[last].arrival_time) last = i;
+    }
+    workload[last].cpu_burst_time1 += SimTime(7);
+    EXPECT(sim.replace(last, workload[last], error));
+    EXPECT(sim.resumed_from() > SimTime(0));
+    EXPECT(matches_full_run(workload));
+
+    workload.push_back(make_process(401, 500, 9, 2, 4, 3));
+    EXPECT(sim.add(workload.back(), error));
+    EXPECT(matches_full_run(workload));
+
+    workload.erase(workload.begin() + 17);
+    EXPECT(sim.remove(17, error));
+    EXPECT(matches_full_run(workload));
+
+    EXPECT(!sim.remove(workload.size(), error));
+}
+
+// ---------------------------------------------------------------------------
+// Decision latency
+// ---------------------------------------------------------------------------
+
+void test_latency_histogram() {
+    // Every value lies in its bucket, and buckets are a quarter octave wide
+    std::vector<uint64_t> values = {0, 1, 2, 3, 4, 5, 7, 8, 9, 1000, std::numeric_limits<uint64_t>::max()};
+    for (int k = 2; k < 64; k++) {
+        values.push_back((uint64_t)1 << k);
+        values.push_back(((uint64_t)1 << k) - 1);
+        values.push_back(((uint64_t)1 << k) + ((uint64_t)1 << (k - 2)));
+    }
+    const size_t top = LatencyHistogram::bucket_of(std::numeric_limits<uint64_t>::max());
+    EXPECT(top < LatencyHistogram::kBuckets);
+    bool contained = true;
+    for (uint64_t v : values) {
+        size_t b = LatencyHistogram::bucket_of(v);
+        uint64_t floor = LatencyHistogram::bucket_floor(b);
+        contained = contained && b <= top && floor <= v && (b == top || v < LatencyHistogram::bucket_floor(b + 1)) &&
+                    (v < 4 || (double)v < floor * 1.25);
+    }
+    EXPECT(contained);
+    for (uint64_t v = 0; v < 4; v++) EXPECT(LatencyHistogram::bucket_of(v) == v);
+
+    LatencyHistogram empty;
+    EXPECT(empty.percentile(0.5) == 0 && empty.mean() == 0);
+
+    // Percentiles are the lower edge of the right bucket, clamped to what was seen
+    LatencyHistogram low, high, all;
+    for (uint64_t v = 1; v <= 1000; v++) {
+        (v <= 500 ? low : high).add(v);
+        all.add(v);
+    }
+    EXPECT(all.percentile(0) == 1);
+    EXPECT(all.percentile(1) <= 1000 && all.percentile(1) * 1.25 > 1000);
+    uint64_t median = all.percentile(0.5);
+    EXPECT(median <= 500 && median * 1.25 > 500);
+    LatencyHistogram one;
+    one.add(37);
+    EXPECT(one.percentile(0) == 37 && one.percentile(0.99) == 37);
+
+    // Merging the halves gives the whole; merging nothing changes nothing
+    low.merge(high);
+    low.merge(LatencyHistogram());
+    EXPECT(low.samples == all.samples && low.total == all.total && low.lowest == all.lowest &&
+           low.highest == all.highest && low.counts == all.counts);
+    EXPECT(low.mean() == 500.5);
+}
+
+// ---------------------------------------------------------------------------
+// Replications
+// ---------------------------------------------------------------------------
+
+bool near(double a, double b, double tolerance) { return std::abs(a - b) <= tolerance; }
+
+void test_replication_statistics() {
+    const std::vector<double> values = {2, 4, 4, 4, 5, 5, 7, 9};
+    MetricSketch whole;
+    for (double v : values) whole.add(v);
+    EXPECT(whole.count() == 8 && whole.mean() == 5 && whole.min() == 2 && whole.max() == 9);
+    EXPECT(near(whole.variance(), 32.0 / 7, 1e-12));
+    EXPECT(near(whole.ci95(), 2.365 * std::sqrt(32.0 / 7) / std::sqrt(8.0), 1e-12));
+
+    // Any split, including an empty side, merges back into the whole
+    for (size_t cut = 0; cut <= values.size(); cut++) {
+        MetricSketch left, right;
+        for (size_t i = 0; i < values.size(); i++) (i < cut ? left : right).add(values[i]);
+        left.merge(right);
+        EXPECT(left.count() == whole.count() && near(left.mean(), whole.mean(), 1e-12) &&
+               near(left.variance(), whole.variance(), 1e-12) && left.min() == whole.min() &&
+               left.max() == whole.max());
+    }
+    MetricSketch single;
+    single.add(3);
+    EXPECT(single.variance() == 0 && single.ci95() == 0);
+
+    // Table values, then the expansion against published quantiles
+    EXPECT(student_t95(0) == 0 && student_t95(1) == 12.706 && student_t95(30) == 2.042);
+    EXPECT(near(student_t95(40), 2.021075, 1e-4));
+    EXPECT(near(student_t95(60), 2.000298, 1e-4));
+    EXPECT(near(student_t95(120), 1.979930, 1e-4));
+    EXPECT(near(student_t95(1000000000), 1.959964, 1e-6));
+    EXPECT(student_t95(31) < student_t95(30));
+
+    // The same workloads whatever the thread count
+    std::vector<ReplicationConfig> configs = {{"policy-rr", SchedulerParams()}, {"policy-sjf", SchedulerParams()}};
+    ReplicationOptions options;
+    options.replications = 12;
+    options.processes = 200;
+    std::vector<ReplicationResult> one_thread, four_threads;
+    std::string error;
+    EXPECT(run_replications(configs, options, one_thread, error));
+    options.threads = 4;
+    EXPECT(run_replications(configs, options, four_threads, error));
+    if (!EXPECT(one_thread.size() == 2 && four_threads.size() == 2)) return;
+    for (size_t c = 0; c < 2; c++) {
+        for (size_t m = 0; m < kReplicatedMetricCount; m++) {
+            const MetricSketch& a = one_thread[c].metrics[m];
+            const MetricSketch& b = four_threads[c].metrics[m];
+            EXPECT(a.count() == 12 && b.count() == 12);
+            EXPECT(near(a.mean(), b.mean(), 1e-9 * std::abs(a.mean())) && a.min() == b.min() && a.max() == b.max());
+        }
+    }
+    EXPECT(!run_replications({{"missing", SchedulerParams()}}, options, one_thread, error));
+}
+
+// ---------------------------------------------------------------------------
+// Result queue
+// ---------------------------------------------------------------------------
+
+void test_mpsc_queue() {
+    MpscQueue<uint64_t> small(5);
+    EXPECT(small.capacity() == 8);
+    uint64_t value = 0;
+    EXPECT(!small.try_pop(value));
+    for (uint64_t i = 0; i < 8; i++) EXPECT(small.try_push(i));
+    EXPECT(!small.try_push(8));
+    EXPECT(small.try_pop(value) && value == 0);
+    EXPECT(small.try_push(8));
+
+    // Every value arrives exactly once, each producer's in its own order
+    constexpr int kProducers = 4;
+    constexpr uint64_t kPerProducer = 50000;
+    MpscQueue<uint64_t> queue(64);
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; p++) {
+        producers.emplace_back([&queue, p] {
+            for (uint64_t i = 0; i < kPerProducer; i++) {
+                uint64_t v = ((uint64_t)p << 32) | i;
+                while (!queue.try_push(v)) std::this_thread::yield();
+            }
+        });
+    }
+    std::vector<uint64_t> next(kProducers, 0);
+    bool in_order = true;
+    for (uint64_t received = 0; received < kProducers * kPerProducer;) {
+        if (!queue.try_pop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        size_t p = value >> 32;
+        in_order = in_order && p < kProducers && (value & 0xFFFFFFFF) == next[p];
+        if (p < kProducers) next[p]++;
+        received++;
+    }
+    for (auto& t : producers) t.join();
+    EXPECT(in_order);
+    EXPECT(!queue.try_pop(value));
+}
+
+// ---------------------------------------------------------------------------
+// Metric kernels
+// ---------------------------------------------------------------------------
+
+void test_metric_kernels_match_scalar() {
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<int64_t> time(0, 1 << 30);
+    MetricColumns columns;
+    for (int i = 0; i < 1003; i++) {
+        int64_t arrival = time(rng), start = arrival + time(rng) % 5000, burst = 1 + time(rng) % 100;
+        columns.push_back(SimTime(arrival), SimTime(burst), SimTime(start), SimTime(start + burst + time(rng) % 50));
+    }
+    const size_t n = columns.size();
+
+    const MetricIsa original = metric_isa();
+    force_metric_isa(MetricIsa::Scalar);
+    MetricTotals expected = metric_totals(columns);
+    std::vector<int64_t> response(n), turnaround(n), waiting(n);
+    derive_metrics(columns, response.data(), turnaround.data(), waiting.data());
+
+    for (MetricIsa isa : {MetricIsa::Avx2, MetricIsa::Avx512}) {
+        if (force_metric_isa(isa) != isa) continue;   // Not on this CPU
+        MetricTotals totals = metric_totals(columns);
+        EXPECT(totals.response == expected.response);
+        EXPECT(totals.turnaround == expected.turnaround);
+        EXPECT(totals.waiting == expected.waiting);
+        EXPECT(totals.burst == expected.burst);
+        EXPECT(totals.last_end == expected.last_end);
+        std::vector<int64_t> r(n), t(n), w(n);
+        derive_metrics(columns, r.data(), t.data(), w.data());
+        EXPECT(r == response && t == turnaround && w == waiting);
+    }
+    force_metric_isa(original);
+}
+
+// Every kernel under every ISA the CPU has, on lengths around the 4- and
+// 8-lane widths (including none) and on values at the int64_t extremes,
+// against plain loops
+int reference_bucket(int64_t value, int64_t lowest, int64_t width, size_t buckets) {
+    if (value < lowest) return 0;
+    uint64_t index = ((uint64_t)value - (uint64_t)lowest) / (uint64_t)width;
+    return (int)std::min<uint64_t>(index, buckets - 1);
+}
+
+void test_metric_kernels_edge_cases() {
+    const int64_t lo = std::numeric_limits<int64_t>::min(), hi = std::numeric_limits<int64_t>::max();
+    const int64_t extremes[] = {hi, lo, hi - 1, lo + 1, 0, -1, 1, hi, lo, 42};
+    std::mt19937_64 rng(7);
+
+    struct Bins {
+        int64_t lowest, width;
+        size_t buckets;
+    };
+    // Narrow buckets take the vector path, a width near 2^63 the scalar one
+    const Bins bins[] = {{-5, 3, 7}, {0, 1, 1}, {lo, (int64_t)1 << 61, 9}, {-100, 10, 20}};
+
+    const MetricIsa original = metric_isa();
+    for (size_t n : {0, 1, 3, 4, 5, 7, 8, 9, 13, 15, 16, 17, 31, 33}) {
+        for (bool extreme : {false, true}) {
+            MetricColumns columns;
+            std::vector<int64_t> values;
+            for (size_t i = 0; i < n; i++) {
+                int64_t a = extreme ? extremes[i % 10] : (int64_t)(rng() % 1000) - 200;
+                int64_t b = extreme ? extremes[(i + 3) % 10] : (int64_t)(rng() % 100);
+                int64_t s = extreme ? extremes[(i + 7) % 10] : a + (int64_t)(rng() % 50);
+                int64_t e = extreme ? extremes[(i * 3 + 1) % 10] : s + b;
+                columns.push_back(SimTime(a), SimTime(b), SimTime(s), SimTime(e));
+                values.push_back(e);
+            }
+
+            // Plain loops; differences wrap like the kernels' lanes
+            auto wrap = [](int64_t x, int64_t y) { return (int64_t)((uint64_t)x - (uint64_t)y); };
+            TimeSum sum, response_sum, turnaround_sum, waiting_sum, burst_sum;
+            int64_t lowest = 0, highest = 0, last_end = lo;   // min_max leaves 0, 0 for no values
+            if (n > 0) lowest = highest = values[0];
+            std::vector<int64_t> response(n), turnaround(n), waiting(n);
+            for (size_t i = 0; i < n; i++) {
+                sum.add(values[i]);
+                lowest = std::min(lowest, values[i]);
+                highest = std::max(highest, values[i]);
+                last_end = std::max(last_end, columns.end[i]);
+                response_sum.add(columns.start[i]);
+                response_sum -= TimeSum(columns.arrival[i] < 0 ? -1 : 0, (uint64_t)columns.arrival[i]);
+                turnaround_sum.add(columns.end[i]);
+                turnaround_sum -= TimeSum(columns.arrival[i] < 0 ? -1 : 0, (uint64_t)columns.arrival[i]);
+                burst_sum.add(columns.burst[i]);
+                response[i] = wrap(columns.start[i], columns.arrival[i]);
+                turnaround[i] = wrap(columns.end[i], columns.arrival[i]);
+                waiting[i] = wrap(turnaround[i], columns.burst[i]);
+            }
+            waiting_sum = turnaround_sum - burst_sum;
+
+            for (MetricIsa isa : {MetricIsa::Scalar, MetricIsa::Avx2, MetricIsa::Avx512}) {
+                if (force_metric_isa(isa) != isa) continue;   // Not on this CPU
+                EXPECT(metric_sum(values.data(), n) == sum);
+                int64_t mn = 0, mx = 0;
+                metric_min_max(values.data(), n, mn, mx);
+                EXPECT(mn == lowest && mx == highest);
+
+                MetricTotals totals = metric_totals(columns);
+                EXPECT(totals.response == response_sum);
+                EXPECT(totals.turnaround == turnaround_sum);
+                EXPECT(totals.waiting == waiting_sum);
+                EXPECT(totals.burst == burst_sum);
+                EXPECT(totals.last_end == (n == 0 ? SimTime(0) : SimTime(last_end)));
+                std::vector<int64_t> r(n), t(n), w(n);
+                derive_metrics(columns, r.data(), t.data(), w.data());
+                EXPECT(r == response && t == turnaround && w == waiting);
+
+                for (const Bins& b : bins) {
+                    std::vector<uint64_t> expected(b.buckets, 0), counts(b.buckets, 0);
+                    for (int64_t v : values) expected[reference_bucket(v, b.lowest, b.width, b.buckets)]++;
+                    metric_histogram(values.data(), n, b.lowest, b.width, counts);
+                    EXPECT(counts == expected);
+                }
+            }
+        }
+    }
+    force_metric_isa(original);
+}
+
+// ---------------------------------------------------------------------------
+// Workload files
+// ---------------------------------------------------------------------------
+
+std::string magic_of(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[8] = {};
+    in.read(magic, sizeof(magic));
+    return std::string(magic, sizeof(magic));
+}
+
+void test_workload_round_trip() {
+    std::vector<Process> narrow = generate_random_workload(50, 7);
+    std::vector<Process> wide = narrow;
+    wide[3].arrival_time = SimTime(5000000000);
+    wide[9].io_time = SimTime(1) + SimTime(INT32_MAX);
+    std::vector<Process> threaded = wide;
+    threaded[0].threads = 6;
+
+    struct Case {
+        const std::vector<Process>* processes;
+        const char* magic;
+    };
+    const Case cases[] = {{&narrow, "SCHDTRC1"}, {&wide, "SCHDTRC2"}, {&threaded, "SCHDTRC3"}};
+    for (const Case& c : cases) {
+        TempFile file("workload.bin");
+        if (!EXPECT(save_workload_binary(file.path, *c.processes))) continue;
+        EXPECT(magic_of(file.path) == c.magic);
+        std::vector<Process> loaded;
+        std::string error;
+        EXPECT(load_workload(file.path, loaded, error));
+        EXPECT(loaded.size() == c.processes->size());
+        for (size_t i = 0; i < loaded.size() && i < c.processes->size(); i++) {
+            EXPECT(same_process(loaded[i], (*c.processes)[i]));
+        }
+    }
+
+    TempFile text("workload.txt");
+    std::vector<Process> loaded;
+    std::string error;
+    EXPECT(save_workload_text(text.path, threaded));
+    EXPECT(load_workload(text.path, loaded, error));
+    EXPECT(loaded.size() == threaded.size());
+    for (size_t i = 0; i < loaded.size() && i < threaded.size(); i++) EXPECT(same_process(loaded[i], threaded[i]));
+
+    // A file cut short is an error, not a shorter workload
+    TempFile cut("cut.bin");
+    EXPECT(save_workload_binary(cut.path, narrow));
+    std::filesystem::resize_file(cut.path, std::filesystem::file_size(cut.path) - 1);
+    EXPECT(!load_workload(cut.path, loaded, error));
+}
+
+// ---------------------------------------------------------------------------
+// Topology and memory placement
+// ---------------------------------------------------------------------------
+
+void test_topology_and_node_affinity() {
+    // 2 sockets of 2 cores with 2 siblings each, one cache per core
+    CpuTopology machine = CpuTopology::uniform(8, 2, 2, 2);
+    EXPECT(machine.size() == 8 && machine.nodes() == 2 && machine.threads_per_core == 2);
+    for (int c = 0; c < machine.size(); c++) {
+        const CpuTopology::Cpu& cpu = machine.cpus[c];
+        EXPECT(cpu.node == c / 4 && cpu.core == c / 2 && cpu.sibling == c % 2 && cpu.llc == c / 2);
+    }
+
+    // Uneven splits give the extra cores to the first sockets; more
+    // sockets or caches than cores are cut down
+    CpuTopology odd = CpuTopology::uniform(5, 2);
+    std::vector<int> nodes;
+    for (const auto& cpu : odd.cpus) nodes.push_back(cpu.node);
+    EXPECT(nodes == std::vector<int>({0, 0, 0, 1, 1}));
+    CpuTopology wide = CpuTopology::uniform(4, 8, 2, 4);
+    EXPECT(wide.nodes() == 2 && wide.cpus[1].llc == 0 && wide.cpus[2].llc == 4);
+    EXPECT(CpuTopology::uniform(0, 1).size() == 1);
+
+    // Node-affine memory: homes go round robin, so P1, P3, ... live on
+    // node 0 (CPUs 0-3) and P2, P4, ... on node 1, and every thread fits
+    // on its home node
+    for (const char* algorithm : {"smp", "gang"}) {
+        int threads = std::string(algorithm) == "smp" ? 2 : 4;
+        std::vector<Process> workload;
+        for (int i = 1; i <= 16 / threads; i++) {
+            workload.push_back(make_process(i, 0, 50));
+            workload.back().threads = threads;
+        }
+        SchedulerParams params;
+        params.set("cpus", 8);
+        params.set("sockets", 2);
+        params.set("remote", 200);
+        params.set("placement", (int)MemoryPlacement::NodeAffine);
+        ScheduleCollector output;
+        if (!EXPECT(run(algorithm, workload, params, output)) || !EXPECT(output.has_slices)) continue;
+        for (const auto& s : output.slices.segments) {
+            if (s.kind != SegmentKind::Cpu) continue;
+            int home = (std::stoi(output.slices.rows[s.row].substr(1)) - 1) % 2;
+            if (!EXPECT(s.resource / 4 == home)) std::cerr << "  " << algorithm << " " << output.slices.rows[s.row] << "\n";
+        }
+        EXPECT(output.cpu_stats.nodes == 2);
+        EXPECT(output.cpu_stats.remote_time == SimTime(0) && output.cpu_stats.numa_stall_time == SimTime(0));
+
+        // Interleaved, every thread has half its pages remote: 50 ticks of
+        // work take 50 * (100 + 200) / 200 = 75
+        params.set("placement", (int)MemoryPlacement::Interleave);
+        ScheduleCollector interleaved;
+        if (!EXPECT(run(algorithm, workload, params, interleaved))) continue;
+        EXPECT(interleaved.cpu_stats.numa_stall_time > SimTime(0));
+        EXPECT(interleaved.cpu_stats.makespan > output.cpu_stats.makespan);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Multi-CPU constraints
+// ---------------------------------------------------------------------------
+
+// CPU-ticks of all CPU segments within [from, to)
+SimTime busy_in(const SegmentTable& table, SimTime from, SimTime to) {
+    SimTime busy{};
+    for (const auto& s : table.segments) {
+        if (s.kind != SegmentKind::Cpu) continue;
+        SimTime start = std::max(s.start, from), end = std::min(s.end, to);
+        if (end > start) busy += end - start;
+    }
+    return busy;
+}
+
+void test_multi_cpu_quota_and_affinity() {
+    std::vector<Process> workload;
+    for (int i = 1; i <= 12; i++) {
+        workload.push_back(make_process(i, 0, 100));
+        workload.back().threads = 2;
+    }
+
+    TempFile limits("limits.txt");
+    {
+        std::ofstream out(limits.path);
+        out << "group capped 300 100   # 3 CPUs' worth\n"
+               "process * group capped\n"
+               "process P1-P4 cpus 6-7\n";
+    }
+    CpuConstraints constraints;
+    std::string error;
+    if (!EXPECT(load_cpu_constraints(limits.path, workload, constraints, error))) {
+        std::cerr << "  " << error << "\n";
+        return;
+    }
+    EXPECT(check_affinity(constraints, workload, 8, error));
+    EXPECT(!check_affinity(constraints, workload, 4, error));
+
+    for (const char* algorithm : {"smp", "gang"}) {
+        SchedulerParams params;
+        params.set("cpus", 8);
+        ScheduleCollector output;
+        output.constraints = &constraints;
+        if (!EXPECT(run(algorithm, workload, params, output))) continue;
+        EXPECT(output.has_cpu_stats && output.has_slices);
+
+        // The group gets its quota per period, give or take the throttle
+        // landing on a whole tick (at most one tick per CPU), so the 2400
+        // CPU-ticks of work take about 8 periods
+        const SegmentTable& table = output.slices;
+        for (SimTime from{}; from < table.end_time; from += SimTime(100)) {
+            if (!EXPECT(busy_in(table, from, from + SimTime(100)) <= SimTime(300 + 8))) {
+                std::cerr << "  " << algorithm << " period at " << from << "\n";
+            }
+        }
+        EXPECT(output.cpu_stats.makespan >= SimTime(800));
+        EXPECT(output.cpu_stats.throttles > 0);
+
+        // P1-P4 run on CPUs 6 and 7 only
+        for (const auto& s : table.segments) {
+            const std::string& pid = table.rows[s.row];
+            bool pinned = pid == "P1" || pid == "P2" || pid == "P3" || pid == "P4";
+            if (s.kind == SegmentKind::Cpu && pinned) EXPECT(s.resource == 6 || s.resource == 7);
+        }
+    }
+}
+
+// Idle time and efficiency over the whole machine: the one-CPU view
+// counts overlapping bursts against the chart's length (smp goes above 1)
+void test_multi_cpu_machine_totals() {
+    std::vector<Process> workload = generate_random_workload(300, 4, 0);
+    assign_random_threads(workload, 6, 4);
+    for (const char* algorithm : {"smp", "gang"}) {
+        ScheduleCollector output;
+        if (!EXPECT(run(algorithm, workload, SchedulerParams(), output)) || !EXPECT(output.has_cpu_stats)) continue;
+        const MultiCpuStats& m = output.cpu_stats;
+        AnalysisSummary summary = GranttAnalysis(output.records, workload).summary();
+        double one_cpu = summary.cpu_efficiency;
+        apply_machine_totals(summary, m);
+        EXPECT(std::fabs(one_cpu - summary.cpu_efficiency) > 0.05);
+        EXPECT(summary.idle_time == m.idle_time && summary.idle_time >= SimTime(0));
+        EXPECT(summary.cpu_efficiency > 0 && summary.cpu_efficiency <= 1);
+        EXPECT(near(summary.cpu_efficiency + (double)m.idle_time.ticks() / m.capacity(), 1, 1e-9));
+    }
+
+    std::vector<ReplicationConfig> configs = {{"gang", SchedulerParams()}};
+    ReplicationOptions options;
+    options.replications = 4;
+    options.processes = 200;
+    options.max_threads = 6;
+    std::vector<ReplicationResult> results;
+    std::string error;
+    if (EXPECT(run_replications(configs, options, results, error))) {
+        EXPECT(results[0].metrics[(size_t)ReplicatedMetric::CpuEfficiency].max() <= 1);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Energy
+// ---------------------------------------------------------------------------
+
+void test_idle_energy_ladder() {
+    EnergyModel model;
+    model.cstates = {{"C1", 1.0, SimTime(0), SimTime(0), SimTime(1)},
+                     {"C3", 0.5, SimTime(10), SimTime(5), SimTime(4)},
+                     {"C6", 0.1, SimTime(30), SimTime(10), SimTime(20)}};
+    struct Case {
+        int length;
+        double energy;
+        int wake;
+    };
+    const Case cases[] = {
+        {0, 0, 0},
+        {8, 8, 1},         // Halted
+        {12, 12, 7},       // Entering C3 (until 15): its exit plus the rest of the entry
+        {15, 15, 4},       // Just in C3
+        {20, 17.5, 4},
+        {35, 25, 25},      // Entering C6 (until 40) at C3's power
+        {50, 28.5, 20},    // 15 at C1, 25 at C3, 10 at C6
+    };
+    for (const Case& c : cases) {
+        SimTime wake(-1);
+        double energy = model.idle_energy(SimTime(c.length), wake);
+        if (!EXPECT(near(energy, c.energy, 1e-9) && wake == SimTime(c.wake))) {
+            std::cerr << "  length " << c.length << ": " << energy << " W-ticks, wake " << wake << "\n";
+        }
+    }
+
+    // Longer idles never cost less, and never more than staying halted
+    double last = 0;
+    for (int length = 0; length <= 100; length++) {
+        SimTime wake;
+        double energy = model.idle_energy(SimTime(length), wake);
+        EXPECT(energy >= last && energy <= length * 1.0 + 1e-9);
+        last = energy;
+    }
+
+    // The typical model's deepest state takes the given exit latency
+    SimTime wake;
+    EnergyModel::typical(SimTime(7)).idle_energy(SimTime(1000000), wake);
+    EXPECT(wake == SimTime(7));
+}
+
+struct Test {
+    const char* name;
+    void (*run)();
+};
+
+const Test tests[] = {
+    {"library_registers_every_scheduler", test_library_registers_every_scheduler},
+    {"registry_and_params", test_registry_and_params},
+    {"gantt_rendering", test_gantt_rendering},
+    {"chrome_trace", test_chrome_trace},
+    {"proportional_shares", test_proportional_shares},
+    {"stride_huge_tickets", test_stride_huge_tickets},
+    {"hrrn_order", test_hrrn_order},
+    {"response_ratio_queue", test_response_ratio_queue},
+    {"srtf_preemption", test_srtf_preemption},
+    {"snapshot_resume_matches_full_run", test_snapshot_resume_matches_full_run},
+    {"snapshot_fork", test_snapshot_fork},
+    {"incremental_simulation", test_incremental_simulation},
+    {"latency_histogram", test_latency_histogram},
+    {"replication_statistics", test_replication_statistics},
+    {"mpsc_queue", test_mpsc_queue},
+    {"metric_kernels_match_scalar", test_metric_kernels_match_scalar},
+    {"metric_kernels_edge_cases", test_metric_kernels_edge_cases},
+    {"workload_round_trip", test_workload_round_trip},
+    {"topology_and_node_affinity", test_topology_and_node_affinity},
+    {"multi_cpu_quota_and_affinity", test_multi_cpu_quota_and_affinity},
+    {"multi_cpu_machine_totals", test_multi_cpu_machine_totals},
+    {"idle_energy_ladder", test_idle_energy_ladder},
+};
+
+}  // namespace
+
+// With arguments, runs only the tests named
+int main(int argc, char** argv) {
+    int failed = 0, ran = 0;
+    for (const Test& test : tests) {
+        if (argc > 1 && std::find_if(argv + 1, argv + argc, [&](const char* a) { return test.name == std::string(a); }) ==
+                            argv + argc) {
+            continue;
+        }
+        int before = failed_checks;
+        test.run();
+        ran++;
+        bool ok = failed_checks == before;
+        if (!ok) failed++;
+        std::cout << (ok ? "ok      " : "FAILED  ") << test.name << "\n";
+    }
+    std::cout << ran << " tests, " << failed << " failed\n";
+    return failed == 0 ? 0 : 1;
+}
@@ -6,18 +6,16 @@
 #include <algorithm>
 #include <fstream>
 #include <sstream>
+#include <cctype>
 
 #include "Process.h"
 #include "ProcessGrantInfo.h"
 #include "GranttAnalysis.h"
-
-// Include all scheduler implementations
-#include "fcfs.cpp"
-#include "sjf.cpp"
-#include "rr.cpp"
-#include "mlfq.cpp"
-#include "fcfsPreemp.cpp"
-#include "priority.cpp"
+#include "Segment.h"
+#include "GanttRenderer.h"
+#include "ChromeTraceWriter.h"
+#include "SchedulerRegistry.h"
+#include "IncrementalSimulation.h"
 
 using namespace std;
 
@@ -30,28 +28,69 @@ void clearScreen() {
 #endif
 }
 
+// Menu entries after the algorithms, which come first and are numbered
+// from the scheduler registry
+enum MenuAction {
+    ENTER_DATA = 1,
+    DISPLAY_DATA,
+    EDIT_DATA,
+    SAVE_DATA,
+    LOAD_DATA,
+    RANDOM_DATA,
+    EXPORT_TRACE,
+    EXIT_PROGRAM
+};
+
+const char* const menu_actions[] = {
+    "Enter Process Data",
+    "Display Current Process Data",
+    "Edit, Add or Remove a Process",
+    "Save Process Data to File",
+    "Load Process Data from File",
+    "Generate Random Processes",
+    "Export Last Schedule as Chrome Trace (JSON)",
+    "Exit",
+};
+
 // Function to display the main menu
 void displayMenu() {
+    const auto& algorithms = SchedulerRegistry::instance().all();
+    int number = 1;
+    
     cout << "\n==================================================\n";
     cout << "           CPU SCHEDULING SIMULATOR           \n";
     cout << "==================================================\n";
-    cout << "  1. First Come First Served (FCFS)\n";
-    cout << "  2. Shortest Job First (SJF) - Non-preemptive\n";
-    cout << "  3. Round Robin (RR)\n";
-    cout << "  4. Multi-Level Feedback Queue (MLFQ)\n";
-    cout << "  5. Priority Scheduling - Non-preemptive\n";
-    cout << "  6. Priority Scheduling - Preemptive\n";
-    cout << "  7. FCFS Preemptive\n";
-    cout << "  8. Enter Process Data\n";
-    cout << "  9. Display Current Process Data\n";
-    cout << "  10. Save Process Data to File\n";
-    cout << "  11. Load Process Data from File\n";
-    cout << "  12. Generate Random Processes\n";
-    cout << "  13. Exit\n";
+    for (const auto& a : algorithms) {
+        cout << "  " << number++ << ". " << a.title << "\n";
+    }
+    cout << "  --------------------------------------------\n";
+    for (const char* action : menu_actions) {
+        cout << "  " << number++ << ". " << action << "\n";
+    }
     cout << "==================================================\n";
     cout << "Enter your choice: ";
 }
 
+// Function to read one process from the user
+Process readProcess(const string& pid) {
+    SimTime arrival_time, cpu_burst1, io_time, cpu_burst2;
+    int priority;
+    
+    cout << "\nProcess " << pid << ":\n";
+    cout << "Arrival Time: ";
+    cin >> arrival_time;
+    cout << "First CPU Burst: ";
+    cin >> cpu_burst1;
+    cout << "I/O Time: ";
+    cin >> io_time;
+    cout << "Second CPU Burst (0 if none): ";
+    cin >> cpu_burst2;
+    cout << "Priority (lower number = higher priority): ";
+    cin >> priority;
+    
+    return Process(pid, arrival_time, cpu_burst1, io_time, cpu_burst2, priority);
+}
+
 // Function to get process data from user
 vector<Process> getProcessData() {
     vector<Process> processes;
@@ -61,21 +100,7 @@ vector<Process> getProcessData() {
     cin >> n;
     
     for (int i = 1; i <= n; i++) {
-        int arrival_time, cpu_burst1, io_time, cpu_burst2, priority;
-        
-        cout << "\nProcess P" << i << ":\n";
-        cout << "Arrival Time: ";
-        cin >> arrival_time;
-        cout << "First CPU Burst: ";
-        cin >> cpu_burst1;
-        cout << "I/O Time: ";
-        cin >> io_time;
-        cout << "Second CPU Burst (0 if none): ";
-        cin >> cpu_burst2;
-        cout << "Priority (lower number = higher priority): ";
-        cin >> priority;
-        
-        processes.push_back(Process("P" + to_string(i), arrival_time, cpu_burst1, io_time, cpu_burst2, priority));
+        processes.push_back(readProcess("P" + to_string(i)));
     }
     
     return processes;
@@ -146,7 +171,8 @@ vector<Process> loadProcessDataFromFile() {
     }
     
     int id = 1;
-    int arrival_time, cpu_burst1, io_time, cpu_burst2, priority;
+    SimTime arrival_time, cpu_burst1, io_time, cpu_burst2;
+    int priority;
     
     while (file >> arrival_time >> cpu_burst1 >> io_time >> cpu_burst2 >> priority) {
         processes.push_back(Process("P" + to_string(id), arrival_time, cpu_burst1, io_time, cpu_burst2, priority));
@@ -172,20 +198,51 @@ vector<Process> generateRandomProcesses() {
         int cpu_burst2 = rand() % 10;  // 0-9
         int priority = 1 + rand() % 10;  // 1-10
         
-        processes.push_back(Process("P" + to_string(i), arrival_time, cpu_burst1, io_time, cpu_burst2, priority));
+        processes.push_back(Process("P" + to_string(i), SimTime(arrival_time), SimTime(cpu_burst1), SimTime(io_time), SimTime(cpu_burst2), priority));
     }
     
     cout << n << " random processes generated.\n";
     return processes;
 }
 
+// Schedule shown by the most recent displayResults() call, kept for export
+vector<ProcessGrantInfo> last_chart;
+
+// Run behind the last results, kept so edits can resume it from a
+// checkpoint; reset whenever the workload is replaced
+IncrementalSimulation last_run;
+string last_title;
+
+// Function to export the last displayed schedule as a Chrome trace
+void exportLastSchedule() {
+    if (last_chart.empty()) {
+        cout << "No schedule to export. Please run an algorithm first.\n";
+        return;
+    }
+    
+    string filename;
+    cout << "Enter filename for the trace (e.g. schedule.json): ";
+    cin >> filename;
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    
+    if (!export_chrome_trace(segments_from_chart(last_chart), filename)) {
+        cout << "Error opening file for writing.\n";
+        return;
+    }
+    
+    cout << "Trace written to " << filename << " (open it in ui.perfetto.dev)\n";
+}
+
 // Function to display Gantt chart and metrics
-void displayResults(const string& algorithm_name, const vector<ProcessGrantInfo>& gantt_chart) {
+void displayResults(const string& algorithm_name, const vector<ProcessGrantInfo>& gantt_chart,
+                    const vector<Process>& processes) {
     if (gantt_chart.empty()) {
         cout << "No results to display.\n";
         return;
     }
     
+    last_chart = gantt_chart;
+    
     cout << "\n==================================================\n";
     cout << "           " << algorithm_name << " Results           \n";
     cout << "==================================================\n";
@@ -193,138 +250,115 @@ void displayResults(const string& algorithm_name, const vector<ProcessGrantInfo>
     // Display Gantt chart
     cout << "\nGantt Chart:\n";
     
-    // Find the maximum end time
-    int max_end_time = 0;
-    for (const auto& info : gantt_chart) {
-        int end_time = max(info.cpu_end_time2 > 0 ? info.cpu_end_time2 : 
-                          (info.io_end_time > 0 ? info.io_end_time : info.cpu_end_time1), 0);
-        max_end_time = max(max_end_time, end_time);
-    }
+    SegmentTable segments = segments_from_chart(gantt_chart);
+    GanttRenderer().print(segments);
     
-    // Create a map of process IDs to their positions in the chart
-    vector<string> process_ids;
-    for (const auto& info : gantt_chart) {
-        bool found = false;
-        for (const auto& id : process_ids) {
-            if (id == info.process.pid) {
-                found = true;
-                break;
-            }
-        }
-        if (!found) {
-            process_ids.push_back(info.process.pid);
-        }
-    }
+    // Metrics per process, however many records the algorithm split it into
+    AnalysisSummary metrics = GranttAnalysis(gantt_chart, processes).summary();
     
-    // Sort process IDs
-    sort(process_ids.begin(), process_ids.end());
+    cout << "\nPerformance Metrics:\n";
+    cout << "Average Waiting Time: " << fixed << setprecision(2) << metrics.avg_waiting_time << "\n";
+    cout << "Average Turnaround Time: " << metrics.avg_turnaround_time << "\n";
+    cout << "Average Response Time: " << metrics.avg_response_time << "\n";
+    cout << "CPU Utilization: " << metrics.cpu_efficiency * 100 << "%\n";
     
-    // Display timeline
-    cout << "     ";
-    for (int t = 0; t <= max_end_time; t += 5) {
-        cout << setw(5) << left << t;
+    cout << "\nPress Enter to continue...";
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    cin.get();
+}
+
+// Function to ask for an algorithm's parameters and run it
+void runAlgorithm(const SchedulerInfo& algorithm, const vector<Process>& processes) {
+    if (processes.empty()) {
+        cout << "No process data available. Please enter process data first.\n";
+        cout << "Press Enter to continue...";
+        cin.get();
+        return;
     }
-    cout << "\n";
     
-    cout << "     ";
-    for (int t = 0; t <= max_end_time; t += 5) {
-        cout << "|    ";
+    SchedulerParams params;
+    string title = algorithm.title;
+    for (const auto& spec : algorithm.params) {
+        cout << "Enter " << spec.name << " (" << spec.description << ", default " << spec.default_value << "): ";
+        string line;
+        getline(cin, line);
+        int value = spec.default_value;
+        if (!line.empty()) {
+            istringstream iss(line);
+            if (!(iss >> value)) value = spec.default_value;
+        }
+        params.set(spec.name, value);
+        title += (&spec == &algorithm.params.front() ? " (" : ", ") + spec.name + " = " + to_string(value);
     }
-    cout << "|\n";
+    if (!algorithm.params.empty()) title += ")";
     
-    // Display process timelines
-    for (const auto& pid : process_ids) {
-        cout << pid << " : ";
-        
-        // Create a timeline for this process
-        string timeline(max_end_time + 1, ' ');
-        
-        for (const auto& info : gantt_chart) {
-            if (info.process.pid == pid) {
-                // Mark CPU bursts with 'C'
-                if (info.cpu_start_time1 >= 0 && info.cpu_end_time1 > 0) {
-                    for (int t = info.cpu_start_time1; t < info.cpu_end_time1; t++) {
-                        if (t < timeline.size()) timeline[t] = 'C';
-                    }
-                }
-                
-                // Mark I/O bursts with 'I'
-                if (info.io_start_time >= 0 && info.io_end_time > 0) {
-                    for (int t = info.io_start_time; t < info.io_end_time; t++) {
-                        if (t < timeline.size()) timeline[t] = 'I';
-                    }
-                }
-                
-                // Mark second CPU bursts with 'C'
-                if (info.cpu_start_time2 >= 0 && info.cpu_end_time2 > 0) {
-                    for (int t = info.cpu_start_time2; t < info.cpu_end_time2; t++) {
-                        if (t < timeline.size()) timeline[t] = 'C';
-                    }
-                }
-            }
-        }
-        
-        // Print the timeline
-        for (int t = 0; t < timeline.size(); t++) {
-            cout << timeline[t];
-        }
-        cout << "\n";
+    string error;
+    if (!last_run.start(algorithm.name, params, processes, error)) {
+        cout << "Error: " << error << "\n";
+        cout << "Press Enter to continue...";
+        cin.get();
+        return;
+    }
+    last_title = title;
+    displayResults(title, last_run.records(), last_run.workload());
+}
+
+// Function to change one process; if an algorithm has been run, its
+// results are brought up to date, re-running only what follows the change.
+// Returns true if it showed the new results.
+bool editProcessData(vector<Process>& processes) {
+    displayProcessData(processes);
+    
+    char action;
+    cout << "\n(e)dit, (a)dd or (r)emove a process: ";
+    cin >> action;
+    action = (char)tolower(action);
+    if (action != 'e' && action != 'a' && action != 'r') {
+        cout << "Invalid choice.\n";
+        return false;
     }
     
-    // Calculate and display metrics
-    double total_wait_time = 0;
-    double total_turnaround_time = 0;
-    double total_response_time = 0;
-    double total_cpu_time = 0;
-    
-    for (const auto& info : gantt_chart) {
-        // Wait time = (start time - arrival time) + any waiting between bursts
-        int wait_time = info.cpu_start_time1 - info.process.arrival_time;
-        if (info.cpu_start_time2 > 0 && info.io_end_time > 0) {
-            wait_time += info.cpu_start_time2 - info.io_end_time;
+    size_t index = processes.size();
+    if (action != 'a') {
+        int number;
+        cout << "Process number (1-" << processes.size() << "): ";
+        if (!(cin >> number) || number < 1 || number > (int)processes.size()) {
+            cin.clear();
+            cout << "No such process.\n";
+            return false;
         }
-        
-        // Turnaround time = completion time - arrival time
-        int completion_time = 0;
-        if (info.cpu_end_time2 > 0) {
-            completion_time = info.cpu_end_time2;
-        } else if (info.io_end_time > 0) {
-            completion_time = info.io_end_time;
-        } else {
-            completion_time = info.cpu_end_time1;
-        }
-        int turnaround_time = completion_time - info.process.arrival_time;
-        
-        // Response time = first CPU start - arrival time
-        int response_time = info.cpu_start_time1 - info.process.arrival_time;
-        
-        // CPU time
-        int cpu_time = (info.cpu_end_time1 - info.cpu_start_time1);
-        if (info.cpu_end_time2 > 0 && info.cpu_start_time2 >= 0) {
-            cpu_time += (info.cpu_end_time2 - info.cpu_start_time2);
-        }
-        
-        total_wait_time += wait_time;
-        total_turnaround_time += turnaround_time;
-        total_response_time += response_time;
-        total_cpu_time += cpu_time;
+        index = number - 1;
     }
     
-    int num_processes = process_ids.size();
-    double avg_wait_time = total_wait_time / num_processes;
-    double avg_turnaround_time = total_turnaround_time / num_processes;
-    double avg_response_time = total_response_time / num_processes;
-    double cpu_utilization = (total_cpu_time / max_end_time) * 100;
+    Process process;
+    if (action == 'e') {
+        process = readProcess(processes[index].pid);
+    } else if (action == 'a') {
+        int next_id = 0;
+        for (const auto& p : processes) next_id = max(next_id, p.process_id);
+        process = readProcess("P" + to_string(next_id + 1));
+    }
     
-    cout << "\nPerformance Metrics:\n";
-    cout << "Average Waiting Time: " << fixed << setprecision(2) << avg_wait_time << "\n";
-    cout << "Average Turnaround Time: " << avg_turnaround_time << "\n";
-    cout << "Average Response Time: " << avg_response_time << "\n";
-    cout << "CPU Utilization: " << cpu_utilization << "%\n";
+    if (!last_run.started()) {
+        if (action == 'e') processes[index] = process;
+        if (action == 'a') processes.push_back(process);
+        if (action == 'r') processes.erase(processes.begin() + index);
+        cout << "Process data updated.\n";
+        return false;
+    }
     
-    cout << "\nPress Enter to continue...";
-    cin.ignore(numeric_limits<streamsize>::max(), '\n');
-    cin.get();
+    string error;
+    bool ok = action == 'e' ? last_run.replace(index, process, error)
+            : action == 'a' ? last_run.add(process, error)
+                            : last_run.remove(index, error);
+    if (!ok) {
+        cout << "Error: " << error << "\n";
+        return false;
+    }
+    processes = last_run.workload();
+    cout << "Re-simulated " << last_run.algorithm_name() << " from time " << last_run.resumed_from() << ".\n";
+    displayResults(last_title, last_run.records(), last_run.workload());
+    return true;
 }
 
 // Main function
@@ -339,146 +373,75 @@ int main() {
     while (!exit_program) {
         clearScreen();
         displayMenu();
-        cin >> choice;
+        if (!(cin >> choice)) {
+            if (cin.eof()) break;
+            cin.clear();
+            choice = 0;
+        }
         
         // Clear input buffer
         cin.ignore(numeric_limits<streamsize>::max(), '\n');
         
-        switch (choice) {
-            case 1: // FCFS
-                if (processes.empty()) {
-                    cout << "No process data available. Please enter process data first.\n";
-                    cout << "Press Enter to continue...";
-                    cin.get();
-                    break;
-                }
-                // Assuming FCFS class exists in fcfs.cpp
-                // FCFS fcfs(processes);
-                // displayResults("FCFS", fcfs.cpu_process());
-                cout << "FCFS not implemented yet.\n";
-                cout << "Press Enter to continue...";
-                cin.get();
-                break;
-                
-            case 2: // SJF
-                if (processes.empty()) {
-                    cout << "No process data available. Please enter process data first.\n";
-                    cout << "Press Enter to continue...";
-                    cin.get();
-                    break;
-                }
-                {
-                    SJF sjf(processes);
-                    displayResults("Shortest Job First", sjf.cpu_process());
-                }
-                break;
-                
-            case 3: // Round Robin
-                if (processes.empty()) {
-                    cout << "No process data available. Please enter process data first.\n";
-                    cout << "Press Enter to continue...";
-                    cin.get();
-                    break;
-                }
-                {
-                    int quantum;
-                    cout << "Enter time quantum for Round Robin: ";
-                    cin >> quantum;
-                    cin.ignore(numeric_limits<streamsize>::max(), '\n');
-                    
-                    RoundRobin rr(processes);
-                    displayResults("Round Robin (Quantum = " + to_string(quantum) + ")", rr.cpu_process(quantum));
-                }
-                break;
-                
-            case 4: // MLFQ
-                if (processes.empty()) {
-                    cout << "No process data available. Please enter process data first.\n";
-                    cout << "Press Enter to continue...";
-                    cin.get();
-                    break;
-                }
-                {
-                    MLFQ mlfq(processes);
-                    displayResults("Multi-Level Feedback Queue", mlfq.cpu_process());
-                }
-                break;
-                
-            case 5: // Priority (Non-preemptive)
-                if (processes.empty()) {
-                    cout << "No process data available. Please enter process data first.\n";
-                    cout << "Press Enter to continue...";
-                    cin.get();
-                    break;
-                }
-                // Assuming Priority class exists in priority.cpp
-                // Priority priority(processes);
-                // displayResults("Priority (Non-preemptive)", priority.cpu_process());
-                cout << "Priority Scheduling (Non-preemptive) not implemented yet.\n";
+        const auto& algorithms = SchedulerRegistry::instance().all();
+        int algorithm_count = (int)algorithms.size();
+        if (choice >= 1 && choice <= algorithm_count) {
+            runAlgorithm(algorithms[choice - 1], processes);
+            continue;
+        }
+        
+        switch (choice - algorithm_count) {
+            case ENTER_DATA:
+                processes = getProcessData();
+                last_run = IncrementalSimulation();
+                cout << "Process data entered successfully.\n";
                 cout << "Press Enter to continue...";
                 cin.get();
                 break;
                 
-            case 6: // Priority (Preemptive)
-                if (processes.empty()) {
-                    cout << "No process data available. Please enter process data first.\n";
-                    cout << "Press Enter to continue...";
-                    cin.get();
-                    break;
-                }
-                // Assuming PriorityPreemptive class exists in priority.cpp
-                // PriorityPreemptive priority_preemptive(processes);
-                // displayResults("Priority (Preemptive)", priority_preemptive.cpu_process());
-                cout << "Priority Scheduling (Preemptive) not implemented yet.\n";
+            case DISPLAY_DATA:
+                displayProcessData(processes);
                 cout << "Press Enter to continue...";
                 cin.get();
                 break;
                 
-            case 7: // FCFS Preemptive
+            case EDIT_DATA:
                 if (processes.empty()) {
-                    cout << "No process data available. Please enter process data first.\n";
-                    cout << "Press Enter to continue...";
-                    cin.get();
+                    displayProcessData(processes);
+                } else if (editProcessData(processes)) {
                     break;
                 }
-                {
-                    FCFSPreemp fcfs_preemp(processes);
-                    displayResults("FCFS Preemptive", fcfs_preemp.cpu_process());
-                }
-                break;
-                
-            case 8: // Enter Process Data
-                processes = getProcessData();
-                cout << "Process data entered successfully.\n";
                 cout << "Press Enter to continue...";
+                cin.ignore(numeric_limits<streamsize>::max(), '\n');
                 cin.get();
                 break;
                 
-            case 9: // Display Current Process Data
-                displayProcessData(processes);
+            case SAVE_DATA:
+                saveProcessDataToFile(processes);
                 cout << "Press Enter to continue...";
                 cin.get();
                 break;
                 
-            case 10: // Save Process Data to File
-                saveProcessDataToFile(processes);
+            case LOAD_DATA:
+                processes = loadProcessDataFromFile();
+                last_run = IncrementalSimulation();
                 cout << "Press Enter to continue...";
                 cin.get();
                 break;
                 
-            case 11: // Load Process Data from File
-                processes = loadProcessDataFromFile();
+            case RANDOM_DATA:
+                processes = generateRandomProcesses();
+                last_run = IncrementalSimulation();
                 cout << "Press Enter to continue...";
                 cin.get();
                 break;
                 
-            case 12: // Generate Random Processes
-                processes = generateRandomProcesses();
+            case EXPORT_TRACE:
+                exportLastSchedule();
                 cout << "Press Enter to continue...";
                 cin.get();
                 break;
                 
-            case 13: // Exit
+            case EXIT_PROGRAM:
                 exit_program = true;
                 break;
                 
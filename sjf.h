@@ -0,0 +1,24 @@
+#ifndef SJF_H
+#define SJF_H
+
+#include <string>
+#include <vector>
+#include "DecisionLatency.h"
+#include "Process.h"
+#include "ProcessGrantInfo.h"
+
+class SJF {
+public:
+    std::vector<Process> processes;
+    std::vector<ProcessGrantInfo> grantt_chart;
+    SimTime current_cpu_time{};
+    std::string ClassName = "SJF";
+    uint32_t decision_sample_every = 0;   // Time every Nth pick; 0 for none
+    DecisionLatency latency;
+
+    SJF(const std::vector<Process>& procs) : processes(procs) {}
+
+    std::vector<ProcessGrantInfo> cpu_process();
+};
+
+#endif